@@ -0,0 +1,125 @@
+#pragma once
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @brief Generates a deterministic list of unique pseudo-English words.
+ *
+ * Letters follow approximate English frequencies so that the resulting trie has realistic
+ * fan-out near the root and long sparse tails.
+ *
+ * @param count Number of unique words.
+ * @param seed Generator seed.
+ * @param min_length Shortest word length.
+ * @param max_length Longest word length.
+ * @return Words in generation order (not sorted).
+ */
+inline std::vector<std::string> makeWords(const size_t count, const unsigned seed = 9, const size_t min_length = 3,
+                                          const size_t max_length = 12) {
+  static constexpr char kLetters[] = "etaoinshrdlcumwfgypbvkjxqz";
+  static constexpr double kWeights[] = {12.0, 9.1, 8.2, 7.5, 7.0, 6.7, 6.3, 6.1, 6.0, 4.3, 4.0, 2.8, 2.8,
+                                        2.4,  2.4, 2.2, 2.0, 2.0, 1.9, 1.5, 1.0, 0.8, 0.2, 0.2, 0.1, 0.1};
+
+  std::mt19937 generator(seed);
+  std::discrete_distribution<size_t> letter(std::begin(kWeights), std::end(kWeights));
+  std::uniform_int_distribution<size_t> length(min_length, max_length);
+
+  std::unordered_set<std::string> seen;
+  std::vector<std::string> words;
+  words.reserve(count);
+  while (words.size() < count) {
+    std::string word(length(generator), ' ');
+    for (char& character : word) {
+      character = kLetters[letter(generator)];
+    }
+    if (seen.insert(word).second) {
+      words.push_back(std::move(word));
+    }
+  }
+  return words;
+}
+
+/**
+ * @brief Runs a callable several times and returns the fastest run.
+ * @param function Work to measure.
+ * @param repeats Number of runs.
+ * @return Best wall-clock time in microseconds.
+ */
+template <typename Function>
+inline double measure(Function&& function, const int repeats = 5) {
+  double best = 0;
+  for (int i = 0; i < repeats; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    function();
+    const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    best = i == 0 ? elapsed.count() : std::min(best, elapsed.count());
+  }
+  return best;
+}
+
+/**
+ * @brief Counts last-level cache misses of the calling thread through perf_event_open.
+ *
+ * Counting starts on construction. Where hardware counters are not available (no PMU in a VM,
+ * perf_event_paranoid too strict, not Linux) every read returns -1.
+ */
+class CacheMisses final {
+public:
+  CacheMisses() {
+#if defined(__linux__)
+    perf_event_attr attributes;
+    std::memset(&attributes, 0, sizeof(attributes));
+    attributes.size = sizeof(attributes);
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    fd = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+#endif
+  }
+  ~CacheMisses() {
+#if defined(__linux__)
+    if (fd >= 0) {
+      close(fd);
+    }
+#endif
+  }
+  CacheMisses(const CacheMisses&) = delete;
+  CacheMisses& operator=(const CacheMisses&) = delete;
+
+  [[nodiscard]] static bool available() { return CacheMisses().fd >= 0; }
+
+  void reset() const {
+#if defined(__linux__)
+    if (fd >= 0) {
+      ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+    }
+#endif
+  }
+
+  [[nodiscard]] long long read() const {
+    long long value = -1;
+#if defined(__linux__)
+    if (fd < 0 || ::read(fd, &value, sizeof(value)) != sizeof(value)) {
+      return -1;
+    }
+#endif
+    return value;
+  }
+
+private:
+  int fd{-1};
+};
@@ -0,0 +1,59 @@
+#include <fcntl.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+#include "../include/ct9/BatchQuery.h"
+#include "../include/ct9/Trie.h"
+#include "Bench.h"
+
+/**
+ * One million prefixes of 1-6 letters against a 3M-word trie, 5 suggestions each, written to
+ * /dev/null: the console loop (std::getline in, std::cout with one line per word out) against
+ * BatchQuery with 1, 2 and 4 threads.
+ */
+int main() {
+  const std::vector<std::string> words = makeWords(3000000, 9);
+  const Trie trie(words);
+
+  std::mt19937 generator(17);
+  std::string input;
+  for (size_t i = 0; i < 1000000; ++i) {
+    const std::string& word = words[generator() % words.size()];
+    input += word.substr(0, 1 + generator() % std::min<size_t>(6, word.size()));
+    input += '\n';
+  }
+  const auto answer = [&](const std::string& prefix) { return trie.autocomplete(prefix, 5); };
+
+  std::ofstream sink("/dev/null");
+  std::istringstream lines(input);
+  size_t queries = 0;
+  const double console = measure(
+      [&] {
+        std::string line;
+        while (std::getline(lines, line)) {
+          std::queue<std::string> result = answer(line);
+          while (!result.empty()) {
+            sink << result.front() << '\n';
+            result.pop();
+          }
+          ++queries;
+        }
+      },
+      1);
+  std::printf("%-16s %10.0f queries/s\n", "getline + cout", queries / console * 1e6);
+
+  const int null_fd = ::open("/dev/null", O_WRONLY | O_CLOEXEC);
+  for (const size_t threads : {1, 2, 4}) {
+    BatchQuery::Options options;
+    options.threads = threads;
+    const BatchQuery::Report report = BatchQuery(options).run(input, null_fd, answer);
+    std::printf("%-9s %zu thr %10.0f queries/s  latency p50 %6.2f  p99 %7.2f  p99.9 %8.2f  max %9.2f us\n", "BatchQuery",
+                threads, report.throughput(), report.p50, report.p99, report.p999, report.max);
+  }
+  ::close(null_fd);
+  return 0;
+}
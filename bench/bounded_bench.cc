@@ -0,0 +1,71 @@
+#include <cstdio>
+#include <random>
+
+#include "../include/ct9/BoundedTrie.h"
+#include "Bench.h"
+
+/**
+ * Hit rate against memory on a replayed query trace. The trace draws 3M queries from 500k words
+ * with Zipf(1.0) popularity; a query that misses inserts its word, like a user accepting a word
+ * the dictionary did not know. For each budget, CLOCK eviction is compared with an oracle that
+ * keeps the most popular words that fit in the same budget and never changes.
+ */
+int main() {
+  const std::vector<std::string> vocabulary = makeWords(500000, 23);
+  std::vector<double> weights(vocabulary.size());
+  for (size_t rank = 0; rank < weights.size(); ++rank) {
+    weights[rank] = 1.0 / static_cast<double>(rank + 1);
+  }
+  std::mt19937 generator(29);
+  std::discrete_distribution<size_t> popularity(weights.begin(), weights.end());
+  std::vector<size_t> trace(3000000);
+  for (size_t& query : trace) {
+    query = popularity(generator);
+  }
+
+  BoundedTrie everything(SIZE_MAX);
+  for (const std::string& word : vocabulary) {
+    everything.insert(word);
+  }
+  const size_t full = everything.bytes();
+  std::printf("all %zu words: %.1f MB (%zu bytes per node)\n\n", vocabulary.size(), full / 1048576.0,
+              BoundedTrie::kNodeBytes);
+  std::printf("%8s %9s %12s %12s %12s %10s\n", "budget", "MB", "CLOCK hits", "oracle hits", "evictions", "ns/query");
+
+  for (const double fraction : {0.01, 0.02, 0.05, 0.1, 0.2, 0.5, 1.0}) {
+    const size_t budget = static_cast<size_t>(fraction * static_cast<double>(full));
+
+    BoundedTrie trie(budget);
+    size_t hits = 0;
+    const double elapsed = measure(
+        [&] {
+          for (const size_t query : trace) {
+            if (trie.contain(vocabulary[query])) {
+              ++hits;
+            } else {
+              trie.insert(vocabulary[query]);
+            }
+          }
+        },
+        1);
+
+    BoundedTrie oracle(SIZE_MAX);
+    std::vector<bool> kept(vocabulary.size(), false);
+    for (size_t rank = 0; rank < vocabulary.size(); ++rank) {
+      oracle.insert(vocabulary[rank]);
+      if (oracle.bytes() > budget) {
+        break;
+      }
+      kept[rank] = true;
+    }
+    size_t oracle_hits = 0;
+    for (const size_t query : trace) {
+      oracle_hits += kept[query] ? 1 : 0;
+    }
+
+    std::printf("%7.0f%% %9.1f %11.1f%% %11.1f%% %12zu %10.0f\n", fraction * 100, budget / 1048576.0,
+                100.0 * hits / trace.size(), 100.0 * oracle_hits / trace.size(), trie.evicted(),
+                elapsed * 1000 / trace.size());
+  }
+  return 0;
+}
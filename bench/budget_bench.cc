@@ -0,0 +1,62 @@
+#include <algorithm>
+#include <cstdio>
+
+#include "../include/ct9/Trie.h"
+#include "Bench.h"
+
+/**
+ * Worst-case keystrokes: one-letter prefixes with a large `count` on a 3M-word trie. Latency of
+ * plain autocomplete() against the bounded variant with a node budget and with a deadline.
+ */
+static void report(const char* label, std::vector<double> latencies, const size_t words) {
+  std::sort(latencies.begin(), latencies.end());
+  std::printf("%-28s p50 %9.0f us  max %9.0f us  %8zu words\n", label, latencies[latencies.size() / 2],
+              latencies.back(), words);
+}
+
+int main() {
+  const Trie trie(makeWords(3000000, 9));
+  const size_t count = 20000;
+
+  std::vector<double> plain;
+  std::vector<double> nodes;
+  std::vector<double> deadline;
+  size_t plain_words = 0;
+  size_t nodes_words = 0;
+  size_t deadline_words = 0;
+  for (char letter = 'a'; letter <= 'z'; ++letter) {
+    const std::string prefix(1, letter);
+    plain.push_back(measure([&] { plain_words += trie.autocomplete(prefix, count).size(); }, 1));
+
+    std::string cursor;
+    nodes.push_back(measure([&] { nodes_words += trie.autocomplete(prefix, count, {20000}, cursor).size(); }, 1));
+
+    cursor.clear();
+    deadline.push_back(measure(
+        [&] {
+          const Trie::Budget budget{SIZE_MAX, std::chrono::steady_clock::now() + std::chrono::milliseconds(2)};
+          deadline_words += trie.autocomplete(prefix, count, budget, cursor).size();
+        },
+        1));
+  }
+  report("autocomplete(p, 20000)", plain, plain_words);
+  report("budget 20000 nodes", nodes, nodes_words);
+  report("deadline 2 ms", deadline, deadline_words);
+
+  // Cost of paging: the whole "e" subtree in 2 ms slices against one unbounded call.
+  std::string cursor;
+  size_t pages = 0;
+  const double paged = measure(
+      [&] {
+        do {
+          const Trie::Budget budget{SIZE_MAX, std::chrono::steady_clock::now() + std::chrono::milliseconds(2)};
+          static_cast<void>(trie.autocomplete("e", INT_MAX, budget, cursor));
+          ++pages;
+        } while (!cursor.empty());
+      },
+      1);
+  const double whole = measure([&] { static_cast<void>(trie.autocomplete("e")); }, 1);
+  std::printf("\nall of \"e\": %.0f ms in one call, %.0f ms in %zu pages of 2 ms\n", whole / 1000, paged / 1000,
+              pages);
+  return 0;
+}
@@ -0,0 +1,57 @@
+#include <cstdio>
+#include <random>
+
+#include "../include/ct9/Trie.h"
+#include "Bench.h"
+
+/**
+ * Bulk membership checks against a trie much larger than the cache: one contain() call per word
+ * against contain_many(), which keeps several lookups in flight.
+ */
+template <typename TrieType>
+static void run(const char* label, const TrieType& trie, const std::vector<std::string>& stored,
+                const std::vector<std::string>& absent) {
+  std::mt19937 generator(5);
+  std::printf("\n%s\n%-8s %14s %14s %8s\n", label, "batch", "contain (M/s)", "many (M/s)", "speedup");
+  for (const size_t batch : {16, 64, 256, 4096, 65536}) {
+    std::vector<std::string> queries;
+    for (size_t i = 0; i < 262144; ++i) {
+      queries.push_back(i % 2 == 0 ? stored[generator() % stored.size()] : absent[generator() % absent.size()]);
+    }
+
+    size_t hits = 0;
+    const double sequential = measure([&] {
+      for (const std::string& query : queries) {
+        hits += trie.contain(query);
+      }
+    });
+    const double interleaved = measure([&] {
+      for (size_t first = 0; first < queries.size(); first += batch) {
+        const std::vector<bool> found = trie.contain_many(std::span(queries).subspan(first, batch));
+        hits += static_cast<size_t>(std::count(found.begin(), found.end(), true));
+      }
+    });
+    std::printf("%-8zu %14.2f %14.2f %7.2fx\n", batch, queries.size() / sequential, queries.size() / interleaved,
+                sequential / interleaved);
+    if (hits == 0) {
+      std::printf("no hits\n");
+    }
+  }
+}
+
+int main() {
+  const std::vector<std::string> words = makeWords(3000000, 9);
+  std::vector<std::string> lowercase = words;
+  std::shuffle(lowercase.begin(), lowercase.end(), std::mt19937(1));
+  const std::vector<std::string> absent = makeWords(100000, 41);
+
+  {
+    const Trie trie(lowercase);
+    run("Trie (std::map children), 3M words", trie, words, absent);
+  }
+  {
+    const LowercaseTrie trie(lowercase);
+    run("LowercaseTrie (dense children), 3M words", trie, words, absent);
+  }
+  return 0;
+}
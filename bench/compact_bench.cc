@@ -0,0 +1,82 @@
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+
+#include "../include/ct9/Trie.h"
+#include "Bench.h"
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+/**
+ * Heap state and autocomplete latency of a trie after insert/del churn, before and after
+ * compact(), and the worst single compactStep() pause next to the heap trim that follows a pass.
+ */
+static double residentMegabytes() {
+  std::ifstream statm("/proc/self/statm");
+  size_t total_pages = 0;
+  size_t resident_pages = 0;
+  statm >> total_pages >> resident_pages;
+  return static_cast<double>(resident_pages * static_cast<size_t>(sysconf(_SC_PAGESIZE))) / 1e6;
+}
+
+static void report(const char* label, const Trie& trie) {
+  const double cold = measure([&] { static_cast<void>(trie.autocomplete("", 100000)); }, 3);
+  std::printf("%-10s nodes %9zu  rss %7.1f MB", label, trie.size(), residentMegabytes());
+#if defined(__GLIBC__)
+  const struct mallinfo2 info = mallinfo2();
+  std::printf("  heap %7.1f MB  free in heap %5.1f%%", static_cast<double>(info.arena) / 1e6,
+              100.0 * static_cast<double>(info.fordblks) / static_cast<double>(info.arena));
+#endif
+  std::printf("  autocomplete(\"\", 100k) %8.0f us\n", cold);
+}
+
+static Trie churn(const std::vector<std::string>& words, const std::vector<std::string>& fresh) {
+  Trie trie(words);
+  std::mt19937 generator(3);
+  std::bernoulli_distribution coin(0.5);
+  size_t next = 0;
+  for (int round = 0; round < 4; ++round) {
+    for (const std::string& word : words) {
+      if (coin(generator)) {
+        trie.del(word);
+      }
+    }
+    for (size_t i = 0; i < words.size() / 4 && next < fresh.size(); ++i) {
+      trie.insert(fresh[next++]);
+    }
+  }
+  return trie;
+}
+
+int main() {
+  const std::vector<std::string> words = makeWords(1000000, 9);
+  const std::vector<std::string> fresh = makeWords(1000000, 23);
+
+  {
+    Trie trie = churn(words, fresh);
+    report("churned", trie);
+    const double elapsed = measure([&] { std::printf("compact() released %.1f MB", trie.compact() / 1e6); }, 1);
+    std::printf(" in %.0f ms\n", elapsed / 1000);
+    report("compacted", trie);
+  }
+
+  for (const size_t budget : {256, 4096}) {
+    Trie trie = churn(words, fresh);
+    double worst = 0;
+    size_t steps = 0;
+    bool done = false;
+    while (!done) {
+      worst = std::max(worst, measure([&] { done = trie.compactStep(budget); }, 1));
+      ++steps;
+    }
+    const double trim = measure([] { Trie::releaseFreeMemory(); }, 1);
+    std::printf("compactStep(%zu): %zu steps, worst pause %.0f us, then releaseFreeMemory() %.0f ms\n", budget, steps,
+                worst, trim / 1000);
+    report("stepped", trie);
+  }
+  return 0;
+}
@@ -0,0 +1,50 @@
+#include <algorithm>
+#include <cstdio>
+#include <random>
+
+#include "../include/ct9/Trie.h"
+#include "Bench.h"
+
+/**
+ * Removing a namespace of words and a sorted batch of words: erase_prefix() and erase_many()
+ * against autocomplete() followed by one del() per word.
+ */
+int main() {
+  const std::vector<std::string> words = makeWords(1000000, 9);
+  std::vector<std::string> all = words;
+  for (const std::string& word : makeWords(200000, 31)) {
+    all.push_back("tmpq" + word);
+  }
+  const Trie base(all);
+
+  Trie trie = base;
+  const double loop = measure([&] {
+    std::queue<std::string> doomed = trie.autocomplete("tmpq", INT_MAX);
+    while (!doomed.empty()) {
+      trie.del(doomed.front());
+      doomed.pop();
+    }
+  }, 1);
+  trie = base;
+  size_t erased = 0;
+  const double subtree = measure([&] { erased = trie.erase_prefix("tmpq"); }, 1);
+  std::printf("namespace of %zu words: autocomplete + del %.1f ms, erase_prefix %.1f ms (%.0fx)\n", erased,
+              loop / 1000, subtree / 1000, loop / subtree);
+
+  std::vector<std::string> batch = words;
+  std::shuffle(batch.begin(), batch.end(), std::mt19937(3));
+  batch.resize(300000);
+  std::sort(batch.begin(), batch.end());
+
+  trie = base;
+  const double single = measure([&] {
+    for (const std::string& word : batch) {
+      trie.del(word);
+    }
+  }, 1);
+  trie = base;
+  const double merged = measure([&] { erased = trie.erase_many(batch); }, 1);
+  std::printf("sorted batch of %zu words: del loop %.1f ms, erase_many %.1f ms (%.1fx)\n", erased, single / 1000,
+              merged / 1000, single / merged);
+  return 0;
+}
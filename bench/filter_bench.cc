@@ -0,0 +1,75 @@
+#include <cstdio>
+#include <random>
+
+#include "../include/ct9/FilteredTrie.h"
+#include "Bench.h"
+
+/**
+ * Spell-check style lookups (mostly absent words) and duplicate-heavy bulk insertion, with and
+ * without the Bloom filter in front of the trie.
+ */
+int main() {
+  const std::vector<std::string> words = makeWords(3000000, 9);
+  const std::vector<std::string> junk = makeWords(1000000, 77, 4, 14);
+  const Trie trie(words);
+  const FilteredTrie filtered(words);
+  std::printf("3M words, filter %.1f MB\n\n", static_cast<double>(filtered.filter().bytes()) / 1e6);
+
+  std::mt19937 generator(5);
+  for (const int present_percent : {0, 10, 50}) {
+    std::vector<std::string> queries;
+    for (size_t i = 0; i < 1000000; ++i) {
+      const bool present = static_cast<int>(generator() % 100) < present_percent;
+      queries.push_back(present ? words[generator() % words.size()] : junk[generator() % junk.size()]);
+    }
+    size_t plain_hits = 0;
+    size_t filtered_hits = 0;
+    const double plain = measure([&] {
+      for (const std::string& query : queries) {
+        plain_hits += trie.contain(query);
+      }
+    }, 3);
+    const double fast = measure([&] {
+      for (const std::string& query : queries) {
+        filtered_hits += filtered.contain(query);
+      }
+    }, 3);
+    std::printf("contain, %2d%% dictionary words: Trie %6.0f ns  FilteredTrie %6.0f ns  (%zu/%zu hits)\n", present_percent,
+                plain * 1000 / queries.size(), fast * 1000 / queries.size(), plain_hits / 3, filtered_hits / 3);
+  }
+
+  size_t false_positives = 0;
+  for (const std::string& word : junk) {
+    false_positives += filtered.filter().mayContain(word) && !trie.contain(word);
+  }
+  std::printf("false positive rate %.2f%%\n\n", 100.0 * static_cast<double>(false_positives) / junk.size());
+
+  const std::vector<std::string> unique = makeWords(500000, 13);
+  std::vector<std::string> input;
+  for (int copy = 0; copy < 5; ++copy) {
+    input.insert(input.end(), unique.begin(), unique.end());
+  }
+  std::shuffle(input.begin(), input.end(), generator);
+  // Alternated and best-of-three: whichever runs second inherits the heap the first one freed.
+  double plain_insert = 0;
+  double filtered_insert = 0;
+  for (int round = 0; round < 3; ++round) {
+    const double plain = measure([&] {
+      Trie target;
+      for (const std::string& word : input) {
+        target.insert(word);
+      }
+    }, 1);
+    const double filtered_run = measure([&] {
+      FilteredTrie target;
+      for (const std::string& word : input) {
+        target.insert(word);
+      }
+    }, 1);
+    plain_insert = round == 0 ? plain : std::min(plain_insert, plain);
+    filtered_insert = round == 0 ? filtered_run : std::min(filtered_insert, filtered_run);
+  }
+  std::printf("insert 2.5M words (5 copies of 500k): Trie %.0f ms  FilteredTrie %.0f ms\n", plain_insert / 1000,
+              filtered_insert / 1000);
+  return 0;
+}
@@ -0,0 +1,93 @@
+#include <cctype>
+#include <cstdio>
+#include <random>
+
+#include "../include/ct9/FoldedTrie.h"
+#include "Bench.h"
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+/**
+ * Case-insensitive suggestions: FoldedTrie against inserting every spelling into a plain Trie.
+ * Every word is stored lowercase and capitalized, and one in ten also in capitals, as in text
+ * where words start sentences and headings. The plain trie has to be asked for all three
+ * spellings of a prefix to be case-insensitive. Heap is the growth of allocated bytes while the
+ * trie is built (glibc only).
+ */
+static size_t allocatedBytes() {
+#if defined(__GLIBC__)
+  return mallinfo2().uordblks;
+#else
+  return 0;
+#endif
+}
+
+int main() {
+  for (const size_t size : {100000, 500000}) {
+    const std::vector<std::string> words = makeWords(size, 48);
+    std::vector<std::string> spellings;
+    std::mt19937 generator(49);
+    for (const std::string& word : words) {
+      spellings.push_back(word);
+      std::string capital = word;
+      capital[0] = static_cast<char>(std::toupper(capital[0]));
+      spellings.push_back(capital);
+      if (std::uniform_int_distribution<int>(0, 9)(generator) == 0) {
+        for (char& character : capital) {
+          character = static_cast<char>(std::toupper(character));
+        }
+        spellings.push_back(capital);
+      }
+    }
+
+    size_t heap = allocatedBytes();
+    const Trie duplicated(spellings);
+    const size_t duplicated_heap = allocatedBytes() - heap;
+    heap = allocatedBytes();
+    const FoldedTrie folded(spellings);
+    const size_t folded_heap = allocatedBytes() - heap;
+    const double duplicated_build = measure([&] { static_cast<void>(Trie(spellings)); }, 1);
+    const double folded_build = measure([&] { static_cast<void>(FoldedTrie(spellings)); }, 1);
+
+    std::printf("%zu words, %zu spellings\n", size, spellings.size());
+    std::printf("%-12s %10s %10s %10s\n", "", "nodes", "heap MB", "build ms");
+    std::printf("%-12s %10zu %10.1f %10.0f\n", "duplicated", duplicated.size(), duplicated_heap / 1048576.0,
+                duplicated_build / 1000);
+    std::printf("%-12s %10zu %10.1f %10.0f\n", "folded", folded.words().size(), folded_heap / 1048576.0,
+                folded_build / 1000);
+
+    std::vector<std::string> prefixes;
+    for (size_t i = 0; i < 1000; ++i) {
+      const std::string& word = words[std::uniform_int_distribution<size_t>(0, words.size() - 1)(generator)];
+      prefixes.push_back(word.substr(0, 3));
+    }
+    size_t duplicated_found = 0;
+    const double duplicated_query = measure([&] {
+      duplicated_found = 0;
+      for (const std::string& prefix : prefixes) {
+        std::string capital = prefix;
+        capital[0] = static_cast<char>(std::toupper(capital[0]));
+        std::string upper = prefix;
+        for (char& character : upper) {
+          character = static_cast<char>(std::toupper(character));
+        }
+        for (const std::string& spelling : {prefix, capital, upper}) {
+          duplicated_found += duplicated.autocomplete(spelling, 10).size();
+        }
+      }
+    });
+    size_t folded_found = 0;
+    const double folded_query = measure([&] {
+      folded_found = 0;
+      for (const std::string& prefix : prefixes) {
+        folded_found += folded.autocomplete(prefix, 30).size();
+      }
+    });
+    std::printf("autocomplete of a 3-letter prefix, any case: duplicated %.2f us (3 walks, %zu spellings), "
+                "folded %.2f us (%zu spellings)\n\n",
+                duplicated_query / prefixes.size(), duplicated_found, folded_query / prefixes.size(), folded_found);
+  }
+  return 0;
+}
@@ -0,0 +1,84 @@
+#include <cstdio>
+#include <random>
+#include <unordered_map>
+
+#include "../include/ct9/Trie.h"
+#include "Bench.h"
+
+/**
+ * Cost of learning from accepted words and of ranking by it. 500k words are loaded and 1M
+ * accepts are drawn with Zipf(1.0) popularity over them, spread over ten half-lives. Ranked
+ * suggestions from frequent() are compared with the lexicographic autocomplete() and with what
+ * ranking costs without the per-node maximum: collecting every word under the prefix and
+ * picking the most used ones from a side table.
+ */
+int main() {
+  const std::vector<std::string> vocabulary = makeWords(500000, 31);
+  Trie trie(vocabulary);
+  trie.set_half_life(std::chrono::hours(1));
+
+  std::vector<double> weights(vocabulary.size());
+  for (size_t rank = 0; rank < weights.size(); ++rank) {
+    weights[rank] = 1.0 / static_cast<double>(rank + 1);
+  }
+  std::mt19937 generator(37);
+  std::discrete_distribution<size_t> popularity(weights.begin(), weights.end());
+  std::vector<size_t> accepts(1000000);
+  for (size_t& accept : accepts) {
+    accept = popularity(generator);
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  std::unordered_map<std::string, double> table;
+  const double learning = measure(
+      [&] {
+        for (size_t i = 0; i < accepts.size(); ++i) {
+          trie.record_use(vocabulary[accepts[i]], start + i * std::chrono::hours(10) / accepts.size());
+        }
+      },
+      1);
+  const auto now = start + std::chrono::hours(10);
+  for (const size_t accept : accepts) {
+    table[vocabulary[accept]] = 0;
+  }
+  for (auto& [word, weight] : table) {
+    weight = trie.usage(word, now);
+  }
+  std::printf("record_use: %.0f ns per accept, %zu distinct words learned\n\n", learning * 1000 / accepts.size(),
+              table.size());
+
+  std::vector<std::string> prefixes;
+  for (const char* prefix : {"", "e", "t", "a", "q", "et", "ta", "in", "er", "zq", "eta", "tin", "ser"}) {
+    prefixes.emplace_back(prefix);
+  }
+
+  std::printf("%8s %10s %14s %14s %14s\n", "prefix", "words", "frequent us", "autocomplete us", "scan+rank us");
+  for (const std::string& prefix : prefixes) {
+    std::queue<std::string> ranked;
+    const double frequent = measure([&] { ranked = trie.frequent(prefix, 5); }, 20);
+    const double lexicographic = measure([&] { static_cast<void>(trie.autocomplete(prefix, 5)); }, 20);
+
+    std::vector<std::pair<double, std::string>> best;
+    const double scan = measure(
+        [&] {
+          best.clear();
+          for (std::queue<std::string> all = trie.autocomplete(prefix); !all.empty(); all.pop()) {
+            const auto found = table.find(all.front());
+            if (found != table.end()) {
+              best.emplace_back(-found->second, all.front());
+            }
+          }
+          const size_t top = std::min<size_t>(5, best.size());
+          std::partial_sort(best.begin(), best.begin() + static_cast<std::ptrdiff_t>(top), best.end());
+          best.resize(top);
+        },
+        3);
+    if (!best.empty() && !ranked.empty() && best.front().second != ranked.front()) {
+      std::printf("  (top word differs from the exact ranking: %s vs %s)\n", ranked.front().c_str(),
+                  best.front().second.c_str());
+    }
+    std::printf("%8s %10zu %14.2f %14.2f %14.0f\n", prefix.empty() ? "\"\"" : prefix.c_str(),
+                trie.autocomplete(prefix).size(), frequent, lexicographic, scan);
+  }
+  return 0;
+}
@@ -0,0 +1,40 @@
+#include <cstdio>
+
+#include "../include/ct9/LayeredTrie.h"
+#include "Bench.h"
+
+/**
+ * Per-session dictionaries: merging a small user trie into the shared base with operator+
+ * against a LayeredTrie view over the shared base.
+ */
+int main() {
+  const std::vector<std::string> base_words = makeWords(200000, 9);
+  const std::vector<std::string> user_words = makeWords(100, 17);
+  const auto base = std::make_shared<const Trie>(base_words);
+  const Trie user(user_words);
+
+  const double merge = measure([&] { const Trie merged = *base + user; }, 1);
+  const double layer = measure([&] {
+    LayeredTrie view(base);
+    for (const std::string& word : user_words) {
+      view.insert(word);
+    }
+  });
+  std::printf("session setup: operator+ %.1f ms, LayeredTrie %.1f us\n", merge / 1000, layer);
+
+  const Trie merged = *base + user;
+  LayeredTrie view(base);
+  for (const std::string& word : user_words) {
+    view.insert(word);
+  }
+  std::printf("per-session nodes: operator+ %zu, LayeredTrie %zu (private layer only)\n", merged.size(), user.size());
+
+  std::printf("\n%-8s %16s %16s\n", "prefix", "merged (us)", "layered (us)");
+  for (const std::string& query : {std::string(), std::string("e"), std::string("th"), std::string("sta"),
+                                   user_words[0].substr(0, 2)}) {
+    const double flat = measure([&] { static_cast<void>(merged.autocomplete(query, 10)); }, 50);
+    const double layered = measure([&] { static_cast<void>(view.autocomplete(query, 10)); }, 50);
+    std::printf("%-8s %16.2f %16.2f\n", query.c_str(), flat, layered);
+  }
+  return 0;
+}
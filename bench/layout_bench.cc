@@ -0,0 +1,49 @@
+#include <cstdio>
+#include <random>
+
+#include "../include/ct9/Trie.h"
+#include "Bench.h"
+
+/**
+ * Subtree enumeration over a trie built in random insertion order (nodes scattered over the
+ * heap) and over the same trie after compact() has laid it out in DFS preorder.
+ */
+static void report(const char* label, const Trie& trie, const std::vector<std::string>& prefixes) {
+  CacheMisses misses;
+  const double full = measure([&] { static_cast<void>(trie.autocomplete("", 200000)); }, 3);
+  const long long full_misses = misses.read();
+
+  misses.reset();
+  const double short_lists = measure(
+      [&] {
+        for (const std::string& prefix : prefixes) {
+          static_cast<void>(trie.autocomplete(prefix, 10));
+        }
+      },
+      3);
+  const long long short_misses = misses.read();
+
+  std::printf("%-10s autocomplete(\"\", 200k) %8.0f us  cache-misses %11lld | %zu x autocomplete(prefix, 10) %8.0f us  "
+              "cache-misses %11lld\n",
+              label, full, full_misses, prefixes.size(), short_lists, short_misses);
+}
+
+int main() {
+  std::vector<std::string> words = makeWords(3000000, 9);
+  std::shuffle(words.begin(), words.end(), std::mt19937(1));
+  Trie trie(words);
+
+  std::vector<std::string> prefixes;
+  for (size_t i = 0; i < 20000; ++i) {
+    prefixes.push_back(words[i * 97 % words.size()].substr(0, 3));
+  }
+
+  if (!CacheMisses::available()) {
+    std::printf("hardware counters unavailable, cache-misses reported as -1\n");
+  }
+  std::printf("%zu words, %zu nodes\n", words.size(), trie.size());
+  report("scattered", trie, prefixes);
+  static_cast<void>(trie.compact());
+  report("preorder", trie, prefixes);
+  return 0;
+}
@@ -0,0 +1,35 @@
+#include <cstdio>
+
+#include "../include/ct9/Trie.h"
+#include "Bench.h"
+
+/**
+ * Wildcard matching: Trie::match against enumerating the whole dictionary with
+ * autocomplete("", INT_MAX) and filtering every word through the same pattern.
+ */
+int main() {
+  const std::vector<std::string> words = makeWords(200000);
+  const Trie trie(words);
+
+  std::printf("%-14s %10s %14s %14s %9s\n", "pattern", "matches", "match (us)", "brute (us)", "speedup");
+  for (const char* pattern : {"c_t", "a?p*", "th*", "s??e*", "[st]?a*e", "*ing", "*q*", "???"}) {
+    size_t matches = 0;
+    const double pruned = measure([&] { matches = trie.match(pattern).size(); });
+    const double brute = measure(
+        [&] {
+          WildcardPattern automaton(pattern);
+          std::queue<std::string> all = trie.autocomplete("", INT_MAX);
+          size_t found = 0;
+          while (!all.empty()) {
+            found += automaton.matches(all.front()) ? 1 : 0;
+            all.pop();
+          }
+          if (found != matches) {
+            std::fprintf(stderr, "mismatch for %s\n", pattern);
+          }
+        },
+        3);
+    std::printf("%-14s %10zu %14.1f %14.1f %8.1fx\n", pattern, matches, pruned, brute, brute / pruned);
+  }
+  return 0;
+}
@@ -0,0 +1,44 @@
+#include <cstdio>
+#include <random>
+
+#include "../include/ct9/Trie.h"
+#include "Bench.h"
+
+/**
+ * Pagination queries on a 3M-word trie: rank(), select() and range() against materializing the
+ * whole word list with autocomplete("", INT_MAX).
+ */
+int main() {
+  const std::vector<std::string> words = makeWords(3000000, 9);
+  const Trie trie(words);
+
+  const double materialize = measure([&] { static_cast<void>(trie.autocomplete("", INT_MAX)); }, 1);
+  std::printf("autocomplete(\"\", INT_MAX): %.0f ms\n", materialize / 1000);
+
+  std::mt19937 generator(3);
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < 100000; ++i) {
+    keys.push_back(words[generator() % words.size()]);
+  }
+  size_t total = 0;
+  const double ranks = measure([&] {
+    for (const std::string& key : keys) {
+      total += trie.rank(key);
+    }
+  });
+  const double selects = measure([&] {
+    for (size_t i = 0; i < keys.size(); ++i) {
+      total += trie.select(generator() % words.size())->size();
+    }
+  });
+  const double ranges = measure([&] {
+    for (size_t i = 0; i < 10000; ++i) {
+      const std::string& lo = keys[i];
+      total += trie.range(lo, lo.substr(0, 2) + "z", 50).size();
+    }
+  });
+  std::printf("rank %.2f us, select %.2f us, range(lo, hi, 50) %.2f us per call (checksum %zu)\n",
+              ranks / keys.size(), selects / keys.size(), ranges / 10000, total % 10);
+
+  return 0;
+}
@@ -0,0 +1,95 @@
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+#include "../include/ct9/TrieHolder.h"
+#include "Bench.h"
+
+/**
+ * Hot reload: peak resident memory while a 1M-word dictionary is rebuilt and swapped in, and
+ * latency of read() + autocomplete() on reader threads with and without a concurrent reload.
+ */
+static long statusKb(const char* field) {
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.rfind(field, 0) == 0) {
+      return std::stol(line.substr(std::string(field).size()));
+    }
+  }
+  return -1;
+}
+
+static std::vector<double> readLatencies(const TrieHolder& holder, const std::vector<std::string>& prefixes,
+                                         const std::atomic<bool>& done) {
+  std::vector<double> latencies;
+  for (size_t i = 0; !done.load(); ++i) {
+    const std::string& prefix = prefixes[i % prefixes.size()];
+    latencies.push_back(measure([&] { static_cast<void>(holder.read()->autocomplete(prefix, 5)); }, 1));
+  }
+  std::sort(latencies.begin(), latencies.end());
+  return latencies;
+}
+
+static void report(const char* phase, std::vector<std::vector<double>> per_reader) {
+  std::vector<double> all;
+  for (const auto& latencies : per_reader) {
+    all.insert(all.end(), latencies.begin(), latencies.end());
+  }
+  std::sort(all.begin(), all.end());
+  std::printf("%-16s reads %9zu  p50 %6.2f us  p99.9 %8.2f us  max %9.2f us\n", phase, all.size(),
+              all[all.size() / 2], all[all.size() * 999 / 1000], all.back());
+}
+
+int main() {
+  const std::vector<std::string> words = makeWords(1000000);
+  const std::filesystem::path path = std::filesystem::temp_directory_path() / "ct9_reload_bench.txt";
+  {
+    std::ofstream file(path);
+    for (const std::string& word : words) {
+      file << word << '\n';
+    }
+  }
+  std::vector<std::string> prefixes;
+  for (size_t i = 0; i < 1000; ++i) {
+    prefixes.push_back(words[i * 997].substr(0, 1 + i % 3));
+  }
+
+  TrieHolder holder;
+  holder.reload(path.string()).get();
+  const long resident = statusKb("VmRSS:");
+  const long peak_before = statusKb("VmHWM:");
+
+  for (const bool reloading : {false, true}) {
+    std::atomic<bool> done{false};
+    std::vector<std::vector<double>> per_reader(4);
+    std::vector<std::thread> readers;
+    for (auto& latencies : per_reader) {
+      readers.emplace_back([&] { latencies = readLatencies(holder, prefixes, done); });
+    }
+    const double elapsed = measure(
+        [&] {
+          if (reloading) {
+            holder.reload(path.string()).get();
+          } else {
+            std::this_thread::sleep_for(std::chrono::seconds(2));
+          }
+        },
+        1);
+    done = true;
+    for (std::thread& reader : readers) {
+      reader.join();
+    }
+    report(reloading ? "during reload" : "steady state", per_reader);
+    if (reloading) {
+      std::printf("reload took %.0f ms, %zu versions still pinned afterwards\n", elapsed / 1000, holder.reclaim());
+    }
+  }
+
+  const long peak_after = statusKb("VmHWM:");
+  std::printf("resident with one version: %ld MB, peak during reload: %ld MB (+%ld MB, peak before %ld MB)\n",
+              resident / 1024, peak_after / 1024, (peak_after - resident) / 1024, peak_before / 1024);
+  std::filesystem::remove(path);
+  return 0;
+}
@@ -0,0 +1,66 @@
+#include <cstdio>
+#include <random>
+
+#include "../include/ct9/Replication.h"
+#include "Bench.h"
+
+/**
+ * Delta replication against shipping the whole word list. A leader with 500k words receives a
+ * batch of changes (half inserts of new words, half deletes of stored ones); the batch is then
+ * diffed against the previous state, encoded and applied to a replica. Diff times include
+ * rehashing the paths the batch touched. The baseline ships every word and rebuilds the replica.
+ */
+int main() {
+  const std::vector<std::string> vocabulary = makeWords(600000, 41);
+  const std::vector<std::string> initial(vocabulary.begin(), vocabulary.begin() + 500000);
+
+  Trie leader(initial);
+  Trie shipped(initial);
+  Trie replica(initial);
+  const double hashing = measure([&] { static_cast<void>(Trie(leader).digest()); }, 1) -
+                         measure([&] { static_cast<void>(Trie(leader)); }, 1);
+  static_cast<void>(leader.digest());
+  static_cast<void>(shipped.digest());
+  static_cast<void>(replica.digest());
+
+  size_t list_bytes = 0;
+  for (const std::string& word : initial) {
+    list_bytes += word.size() + 1;
+  }
+  const double rebuild = measure([&] { static_cast<void>(Trie(initial)); }, 1);
+  std::printf("500k words: full list %.1f MB, rebuild %.0f ms, hashing every node %.0f ms\n\n",
+              list_bytes / 1048576.0, rebuild / 1000, hashing / 1000);
+
+  std::printf("%8s %12s %12s %12s %12s\n", "changes", "frame bytes", "diff us", "apply us", "encode us");
+  std::mt19937 generator(43);
+  std::vector<std::string> present = initial;
+  size_t next_new = 500000;
+  for (const size_t changes : {1, 10, 100, 1000, 10000, 50000}) {
+    for (size_t i = 0; i < changes; ++i) {
+      if (i % 2 == 0 && next_new < vocabulary.size()) {
+        leader.insert(vocabulary[next_new]);
+        present.push_back(vocabulary[next_new++]);
+      } else {
+        const size_t victim = std::uniform_int_distribution<size_t>(0, present.size() - 1)(generator);
+        leader.del(present[victim]);
+        present[victim] = present.back();
+        present.pop_back();
+      }
+    }
+
+    DeltaFrame frame;
+    const double diff = measure([&] { frame.delta = shipped.diff(leader); }, 1);
+    frame.base = shipped.digest();
+    shipped.apply(frame.delta);
+    frame.target = shipped.digest();
+    std::string bytes;
+    const double encode = measure([&] { bytes = frame.encode(); }, 1);
+    const double apply = measure([&] { replica.apply(frame.delta); }, 1);
+    if (replica.digest() != leader.digest()) {
+      std::printf("replica diverged\n");
+      return 1;
+    }
+    std::printf("%8zu %12zu %12.0f %12.0f %12.0f\n", changes, bytes.size(), diff, apply, encode);
+  }
+  return 0;
+}
@@ -0,0 +1,64 @@
+#include <cstdio>
+#include <random>
+
+#include "../include/ct9/AhoCorasick.h"
+#include "Bench.h"
+
+/**
+ * Finding dictionary words in unspaced text: a contain() call for every (position, length) pair,
+ * one longest_prefix_match() descent per position, one Aho-Corasick pass with scan(), and count(),
+ * which runs several passes over parts of the text in lockstep.
+ */
+static void run(const size_t dictionary, const size_t min_length, const size_t max_length) {
+  const std::vector<std::string> words = makeWords(dictionary, 9, min_length, max_length);
+  const Trie trie(words);
+  const AhoCorasick scanner(trie);
+
+  // Concatenated words of another list, about half of them also in the dictionary.
+  std::mt19937 generator(3);
+  const std::vector<std::string> filler = makeWords(100000, 77);
+  std::string text;
+  while (text.size() < (16u << 20)) {
+    text += generator() % 2 == 0 ? words[generator() % words.size()] : filler[generator() % filler.size()];
+  }
+  const std::string sample = text.substr(0, 1u << 20);
+
+  size_t naive_hits = 0;
+  const double naive = measure(
+      [&] {
+        for (size_t begin = 0; begin < sample.size(); ++begin) {
+          for (size_t length = min_length; length <= max_length && begin + length <= sample.size(); ++length) {
+            naive_hits += trie.contain(sample.substr(begin, length));
+          }
+        }
+      },
+      1);
+  size_t longest = 0;
+  const double descents = measure([&] {
+    for (size_t begin = 0; begin < text.size(); ++begin) {
+      longest += trie.longest_prefix_match(std::string_view(text).substr(begin));
+    }
+  });
+  size_t matches = 0;
+  const double scan = measure([&] { scanner.scan(text, [&](size_t, size_t) { ++matches; }); });
+  size_t counted = 0;
+  const double count = measure([&] { counted = scanner.count(text); });
+
+  std::printf("\n%zu words of %zu-%zu letters, %zu states, %zu MB automaton, %zu MB text, %zu matches\n", dictionary,
+              min_length, max_length, scanner.states(), scanner.bytes() >> 20, text.size() >> 20, counted);
+  std::printf("%-24s %10.1f MB/s\n", "contain per (pos, len)", sample.size() / naive);
+  std::printf("%-24s %10.1f MB/s\n", "longest_prefix_match", text.size() / descents);
+  std::printf("%-24s %10.1f MB/s\n", "AhoCorasick::scan", text.size() / scan);
+  std::printf("%-24s %10.1f MB/s\n", "AhoCorasick::count", text.size() / count);
+  if (naive_hits + longest == 0 || matches != 5 * counted) {
+    std::printf("unexpected results\n");
+  }
+}
+
+int main() {
+  run(1000, 3, 12);
+  run(100000, 3, 12);
+  run(1000, 8, 16);
+  run(100000, 8, 16);
+  return 0;
+}
@@ -0,0 +1,48 @@
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+#include "../include/ct9/ShardedTrie.h"
+#include "Bench.h"
+
+/**
+ * Insert throughput with 1 to 32 writer threads: one Trie behind a global mutex against a
+ * ShardedTrie with a lock per leading byte. Every thread inserts its own slice of the words.
+ */
+template <typename Insert>
+static double run(const std::vector<std::string>& words, const size_t threads, Insert&& insert) {
+  return measure(
+      [&] {
+        std::vector<std::thread> writers;
+        for (size_t thread = 0; thread < threads; ++thread) {
+          writers.emplace_back([&, thread] {
+            for (size_t i = thread; i < words.size(); i += threads) {
+              insert(words[i]);
+            }
+          });
+        }
+        for (std::thread& writer : writers) {
+          writer.join();
+        }
+      },
+      1);
+}
+
+int main() {
+  const std::vector<std::string> words = makeWords(1000000, 9);
+  std::printf("%u hardware threads\n%-8s %18s %18s\n", std::thread::hardware_concurrency(), "threads",
+              "global lock (M/s)", "sharded (M/s)");
+  for (const size_t threads : {1, 2, 4, 8, 16, 32}) {
+    Trie trie;
+    std::mutex lock;
+    const double global = run(words, threads, [&](const std::string& word) {
+      std::lock_guard guard(lock);
+      trie.insert(word);
+    });
+
+    ShardedTrie sharded;
+    const double split = run(words, threads, [&](const std::string& word) { sharded.insert(word); });
+    std::printf("%-8zu %18.2f %18.2f\n", threads, words.size() / global, words.size() / split);
+  }
+  return 0;
+}
@@ -0,0 +1,80 @@
+#include <cstdio>
+#include <random>
+
+#include "../include/ct9/BoundedTrie.h"
+#include "../include/ct9/SubstringIndex.h"
+#include "Bench.h"
+
+/**
+ * Infix queries: the suffix automaton against scanning every word from autocomplete("", INT_MAX)
+ * with std::string::find. Queries are random substrings of dictionary words of a given length,
+ * asking for the first 10 matches and for all of them. The trie size is its node count times
+ * BoundedTrie::kNodeBytes.
+ */
+int main() {
+  for (const size_t size : {100000, 500000}) {
+    const std::vector<std::string> words = makeWords(size, 47);
+    const Trie trie(words);
+    size_t characters = 0;
+    for (const std::string& word : words) {
+      characters += word.size();
+    }
+
+    const double build = measure([&] { static_cast<void>(SubstringIndex(trie)); }, 1);
+    const SubstringIndex index(trie);
+    std::printf("%zu words, %zu characters: trie %.1f MB, index %.1f MB (%zu states, %.1f bytes per character), "
+                "built in %.0f ms\n",
+                size, characters, (trie.size() + 1) * BoundedTrie::kNodeBytes / 1048576.0, index.bytes() / 1048576.0,
+                index.states(), static_cast<double>(index.bytes()) / static_cast<double>(characters), build / 1000);
+
+    std::mt19937 generator(53);
+    std::printf("%8s %10s %14s %14s %14s\n", "|q|", "matches", "index k=10 us", "index all us", "scan all us");
+    for (const size_t length : {2, 3, 4, 6}) {
+      std::vector<std::string> queries;
+      while (queries.size() < 20) {
+        const std::string& word = words[std::uniform_int_distribution<size_t>(0, words.size() - 1)(generator)];
+        if (word.size() >= length) {
+          queries.push_back(word.substr(std::uniform_int_distribution<size_t>(0, word.size() - length)(generator),
+                                        length));
+        }
+      }
+
+      size_t matches = 0;
+      const double top = measure(
+          [&] {
+            for (const std::string& query : queries) {
+              static_cast<void>(index.contains_substring(query, 10));
+            }
+          },
+          5);
+      const double all = measure(
+          [&] {
+            matches = 0;
+            for (const std::string& query : queries) {
+              matches += index.contains_substring(query).size();
+            }
+          },
+          3);
+      size_t scanned = 0;
+      const double scan = measure(
+          [&] {
+            scanned = 0;
+            for (const std::string& query : queries) {
+              for (std::queue<std::string> all_words = trie.autocomplete("", INT_MAX); !all_words.empty();
+                   all_words.pop()) {
+                scanned += all_words.front().find(query) != std::string::npos ? 1 : 0;
+              }
+            }
+          },
+          1);
+      if (scanned != matches) {
+        std::printf("mismatch: %zu vs %zu\n", matches, scanned);
+        return 1;
+      }
+      std::printf("%8zu %10zu %14.1f %14.0f %14.0f\n", length, matches / queries.size(), top / queries.size(),
+                  all / queries.size(), scan / queries.size());
+    }
+    std::printf("\n");
+  }
+  return 0;
+}
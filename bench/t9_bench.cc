@@ -0,0 +1,33 @@
+#include <cstdio>
+
+#include "../include/ct9/T9Index.h"
+#include "Bench.h"
+
+/**
+ * T9 lookup latency per keypress: frontier walk over the Trie against the digit-keyed T9Index,
+ * for every prefix of a few typed words.
+ */
+int main() {
+  const std::vector<std::string> words = makeWords(1000000);
+  Trie trie;
+  for (const std::string& word : words) {
+    trie.insert(word);
+  }
+
+  const double build = measure([&] { const T9Index index(trie); }, 1);
+  const T9Index index(trie);
+  std::printf("1M words, T9Index build: %.0f ms\n\n", build / 1000);
+
+  std::printf("%-14s %8s %16s %16s\n", "digits", "matches", "trie walk (us)", "index (us)");
+  for (const std::string& word : {words[0], words[1], words[2], std::string("thereon")}) {
+    const std::string digits = T9Index::encode(word);
+    for (size_t length = 1; length <= digits.size(); ++length) {
+      const std::string typed = digits.substr(0, length);
+      size_t matches = 0;
+      const double walk = measure([&] { matches = trie.t9_lookup(typed, 10).size(); }, 20);
+      const double lookup = measure([&] { static_cast<void>(index.t9_lookup(typed, 10)); }, 20);
+      std::printf("%-14s %8zu %16.2f %16.2f\n", typed.c_str(), matches, walk, lookup);
+    }
+  }
+  return 0;
+}
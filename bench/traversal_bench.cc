@@ -0,0 +1,63 @@
+#include <cstdio>
+#include <memory>
+
+#include "../include/ct9/LayeredTrie.h"
+#include "Bench.h"
+
+/**
+ * The whole-trie walks: insert, size(), autocomplete of every word, a wildcard match, a layered
+ * autocomplete and destruction, on 500k dictionary words. The last line inserts a single line of
+ * one million letters, as a minified file read as a dictionary would give.
+ */
+int main() {
+  const std::vector<std::string> words = makeWords(500000, 49);
+  std::string text;
+  for (const std::string& word : words) {
+    text += word;
+    text += ' ';
+  }
+
+  const double insert = measure([&] { static_cast<void>(Trie(words)); }, 3);
+  const double separated = measure([&] { static_cast<void>(Trie(text)); }, 3);
+  double destroy = 0;
+  for (int i = 0; i < 3; ++i) {
+    auto doomed = std::make_unique<Trie>(words);
+    const double elapsed = measure([&] { doomed.reset(); }, 1);
+    destroy = i == 0 ? elapsed : std::min(destroy, elapsed);
+  }
+  const auto trie = std::make_shared<const Trie>(words);
+  size_t nodes = 0;
+  const double size = measure([&] { nodes = trie->size(); });
+  const double all = measure([&] { static_cast<void>(trie->autocomplete("", INT_MAX)); });
+  const double top = measure([&] {
+    for (const std::string& word : words) {
+      static_cast<void>(trie->autocomplete(word.substr(0, 2), 10));
+    }
+  });
+  const double match = measure([&] { static_cast<void>(trie->match("*e*a*")); });
+  LayeredTrie layered(trie);
+  for (size_t i = 0; i < words.size(); i += 100) {
+    layered.del(words[i]);
+  }
+  const double layers = measure([&] { static_cast<void>(layered.autocomplete("", INT_MAX)); });
+
+  std::printf("500k words, %zu nodes\n", nodes);
+  std::printf("%-40s %10.0f us\n", "insert every word", insert);
+  std::printf("%-40s %10.0f us\n", "insert one text of all words", separated);
+  std::printf("%-40s %10.0f us\n", "destroy", destroy);
+  std::printf("%-40s %10.0f us\n", "size()", size);
+  std::printf("%-40s %10.0f us\n", "autocomplete(\"\", all)", all);
+  std::printf("%-40s %10.3f us\n", "autocomplete(2 letters, 10), per call", top / words.size());
+  std::printf("%-40s %10.0f us\n", "match(\"*e*a*\")", match);
+  std::printf("%-40s %10.0f us\n", "layered autocomplete(\"\", all)", layers);
+
+  const std::string line(1000000, 'x');
+  const double deep = measure(
+      [&] {
+        Trie blob(line);
+        static_cast<void>(blob.autocomplete("", 1));
+      },
+      1);
+  std::printf("%-40s %10.0f us\n", "insert, read and free a 1M-letter key", deep);
+  return 0;
+}
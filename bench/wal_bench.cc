@@ -0,0 +1,40 @@
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+
+#include "../include/ct9/WriteAheadLog.h"
+#include "Bench.h"
+
+/**
+ * Write-ahead log: latency of insert() as seen by the caller and time until all records are
+ * durable, for several group-commit batch sizes with fsync enabled.
+ */
+int main() {
+  const std::vector<std::string> words = makeWords(20000);
+  const std::filesystem::path directory = std::filesystem::temp_directory_path() / "ct9_wal_bench";
+
+  std::printf("%8s %14s %14s %16s\n", "batch", "append p50 us", "append max us", "durable after ms");
+  for (const size_t batch : {1, 16, 64, 256}) {
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    WriteAheadLog::Options options;
+    options.batch_records = batch;
+    WriteAheadLog wal((directory / "snapshot").string(), (directory / "wal").string(), options);
+
+    std::vector<double> latencies;
+    latencies.reserve(words.size());
+    const auto start = std::chrono::steady_clock::now();
+    for (const std::string& word : words) {
+      latencies.push_back(measure([&] { wal.insert(word); }, 1));
+    }
+    wal.sync();
+    const std::chrono::duration<double, std::milli> total = std::chrono::steady_clock::now() - start;
+
+    std::sort(latencies.begin(), latencies.end());
+    std::printf("%8zu %14.2f %14.2f %16.1f\n", batch, latencies[latencies.size() / 2], latencies.back(),
+                total.count());
+  }
+  std::filesystem::remove_all(directory);
+  return 0;
+}
@@ -0,0 +1,126 @@
+#include <poll.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+
+#include "../include/ct9/SuggestionWorker.h"
+#include "../include/ct9/Trie.h"
+#include "Bench.h"
+
+/**
+ * Simulated typing session against a 3M-word trie: one key every kInterval, Return after every
+ * word, and a full dump of the dictionary (what WriteAheadLog::compact() does) every 100 words.
+ * The event loop either computes suggestions itself or hands them to a SuggestionWorker.
+ * Reported: how long each key blocks the loop, and keypress-to-suggestion latency measured from
+ * the moment the key was due.
+ */
+static constexpr auto kInterval = std::chrono::milliseconds(8);
+
+using Clock = std::chrono::steady_clock;
+
+static std::string keys() {
+  const std::vector<std::string> words = makeWords(300, 71);
+  std::string typed;
+  for (const std::string& word : words) {
+    typed += word + '\n';
+  }
+  return typed;
+}
+
+static void report(const char* label, std::vector<double> blocked, std::vector<double> latency) {
+  std::sort(blocked.begin(), blocked.end());
+  std::sort(latency.begin(), latency.end());
+  const auto at = [](const std::vector<double>& values, const double p) {
+    return values[static_cast<size_t>(p * static_cast<double>(values.size() - 1))] / 1000;
+  };
+  std::printf("%-10s blocked p50 %7.3f  p99 %8.3f  max %8.3f ms | latency p50 %7.3f  p99 %8.3f  max %8.3f ms\n",
+              label, at(blocked, 0.5), at(blocked, 0.99), blocked.back() / 1000, at(latency, 0.5),
+              at(latency, 0.99), latency.back() / 1000);
+}
+
+static double since(const Clock::time_point start) {
+  return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+int main() {
+  Trie trie(makeWords(3000000, 9));
+  const std::string typed = keys();
+  size_t inserted = 0;
+  size_t sink = 0;
+
+  const auto suggest = [&](const std::string& prefix) { return trie.autocomplete(prefix, 10); };
+  const auto commit = [&](const std::string& word) {
+    trie.insert(word);
+    if (++inserted % 100 == 0) {
+      sink += trie.autocomplete("").size();
+    }
+  };
+
+  {
+    std::vector<double> blocked;
+    std::vector<double> latency;
+    std::string input;
+    const Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < typed.size(); ++i) {
+      const Clock::time_point due = start + i * kInterval;
+      std::this_thread::sleep_until(due);
+      const Clock::time_point pressed = Clock::now();
+      if (typed[i] == '\n') {
+        commit(input);
+        input.clear();
+      } else {
+        input.push_back(typed[i]);
+      }
+      sink += suggest(input).size();
+      blocked.push_back(since(pressed));
+      latency.push_back(since(due));
+    }
+    report("inline", blocked, latency);
+  }
+
+  {
+    std::vector<double> blocked;
+    std::vector<double> latency;
+    std::vector<Clock::time_point> waiting;
+    std::string input;
+    SuggestionWorker worker(suggest);
+    std::uint64_t latest = 0;
+    const Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < typed.size() || !waiting.empty();) {
+      const Clock::time_point due = start + i * kInterval;
+      int timeout = -1;
+      if (i < typed.size()) {
+        timeout = static_cast<int>(
+            std::max<std::int64_t>(0, std::chrono::ceil<std::chrono::milliseconds>(due - Clock::now()).count()));
+      }
+      pollfd descriptor{worker.fd(), POLLIN, 0};
+      if (poll(&descriptor, 1, timeout) == 1) {
+        if (auto result = worker.take(); result.has_value() && result->ticket == latest) {
+          sink += result->words.size();
+          for (const Clock::time_point pressed : waiting) {
+            latency.push_back(since(pressed));
+          }
+          waiting.clear();
+        }
+        continue;
+      }
+
+      const Clock::time_point pressed = Clock::now();
+      if (typed[i] == '\n') {
+        worker.post([&commit, word = input] { commit(word); });
+        input.clear();
+      } else {
+        input.push_back(typed[i]);
+      }
+      latest = worker.request(input);
+      blocked.push_back(since(pressed));
+      waiting.push_back(due);
+      ++i;
+    }
+    report("worker", blocked, latency);
+    std::printf("%llu of %zu requests dropped as stale\n", static_cast<unsigned long long>(worker.dropped()),
+                typed.size());
+  }
+  return sink == 0 ? 1 : 0;
+}
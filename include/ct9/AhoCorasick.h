@@ -0,0 +1,206 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "StaticTrie.h"
+#include "Trie.h"
+
+/**
+ * @brief Multi-pattern scanner: finds every occurrence of every dictionary word in one pass.
+ *
+ * Built from a trie flattened breadth-first (StaticTrie::flatten). Every state gets a failure link
+ * to the longest proper suffix of its key that is also a trie path, and an output link to the
+ * longest proper suffix that is a word. The failure links are then folded into a complete
+ * transition table, so scanning costs exactly one table load per input character, however long
+ * the failure chains are, and the text is processed in time linear in its length plus the number
+ * of matches.
+ *
+ * The table has one column per byte class: every byte that occurs in some word gets a class of
+ * its own, all other bytes share class 0, which always leads back to the root. It takes
+ * states * classes * 4 bytes, e.g. 48 MB for 100k words of 26 letters. Table entries are 31-bit
+ * offsets, so states * classes must stay below 2^31 (about 40M states for both cases of 26
+ * letters); the constructor throws std::length_error for larger dictionaries.
+ */
+class AhoCorasick final {
+public:
+  template <typename Alphabet>
+  explicit AhoCorasick(const BasicTrie<Alphabet>& trie);
+
+  template <typename Callback>
+  void scan(std::string_view text, Callback&& on_match) const;
+  [[nodiscard]] size_t count(std::string_view text) const;
+  [[nodiscard]] size_t states() const noexcept { return output.size(); }
+  [[nodiscard]] size_t bytes() const noexcept;
+
+private:
+  static constexpr std::uint32_t kNone = UINT32_MAX;
+  // Set on table entries whose target state ends at least one word.
+  static constexpr std::uint32_t kReports = 1u << 31;
+  // Independent scans count() keeps in flight, like BasicTrie::lookupMany().
+  static constexpr size_t kLanes = 8;
+
+  template <typename Callback>
+  void report(std::uint32_t row, size_t end, Callback& on_match) const;
+  [[nodiscard]] bool isWord(std::uint32_t state) const noexcept { return words[state / 64] >> (state % 64) & 1; }
+
+  // Up to 256 byte classes plus class 0, so one byte is not enough.
+  std::array<std::uint16_t, 256> classes{};
+  std::uint32_t width{1};
+  size_t longest{0};
+  // Entries are target state * width, so a step needs no multiplication.
+  std::vector<std::uint32_t> delta;
+  std::vector<std::uint32_t> output;
+  std::vector<std::uint16_t> depth;
+  std::vector<std::uint64_t> words;
+};
+
+/**
+ * @brief Builds the automaton from every word of a trie.
+ *
+ * States are numbered breadth-first, so the failure link of a state and the row it inherits its
+ * missing transitions from always belong to states with smaller numbers, and the whole table is
+ * filled in a single pass.
+ *
+ * @param trie Dictionary to search for. Words longer than 65535 characters are not supported.
+ * @throws std::length_error if the transition table would not fit 31-bit entries.
+ */
+template <typename Alphabet>
+inline AhoCorasick::AhoCorasick(const BasicTrie<Alphabet>& trie) {
+  const std::vector<StaticTrie::Node> nodes = StaticTrie::flatten(trie);
+  for (size_t state = 1; state < nodes.size(); ++state) {
+    std::uint16_t& column = classes[static_cast<unsigned char>(nodes[state].label)];
+    if (column == 0) {
+      column = static_cast<std::uint16_t>(width++);
+    }
+  }
+  if (nodes.size() * width >= kReports) {
+    throw std::length_error("AhoCorasick: states * byte classes must stay below 2^31");
+  }
+
+  delta.assign(nodes.size() * width, 0);
+  output.assign(nodes.size(), kNone);
+  depth.assign(nodes.size(), 0);
+  words.assign(nodes.size() / 64 + 1, 0);
+  std::vector<std::uint32_t> fail(nodes.size(), 0);
+  for (size_t state = 1; state < nodes.size(); ++state) {
+    // The empty word would match between every two characters; it is not reported.
+    if (nodes[state].end_of_word) {
+      words[state / 64] |= std::uint64_t{1} << (state % 64);
+    }
+  }
+
+  for (std::uint32_t state = 0; state < nodes.size(); ++state) {
+    std::uint32_t* row = delta.data() + static_cast<size_t>(state) * width;
+    if (state != 0) {
+      const std::uint32_t* inherited = delta.data() + static_cast<size_t>(fail[state]) * width;
+      std::copy(inherited, inherited + width, row);
+    }
+    const StaticTrie::Node& parent = nodes[state];
+    for (std::uint32_t child = parent.first_child; child < parent.first_child + parent.child_count; ++child) {
+      const std::uint16_t column = classes[static_cast<unsigned char>(nodes[child].label)];
+      fail[child] = state == 0 ? 0 : row[column] / width;
+      output[child] = isWord(fail[child]) ? fail[child] : output[fail[child]];
+      depth[child] = static_cast<std::uint16_t>(depth[state] + 1);
+      longest = std::max<size_t>(longest, depth[child]);
+      row[column] = child * width;
+    }
+  }
+
+  for (std::uint32_t& entry : delta) {
+    const std::uint32_t target = entry / width;
+    if (isWord(target) || output[target] != kNone) {
+      entry |= kReports;
+    }
+  }
+}
+
+/**
+ * @brief Memory taken by the automaton.
+ */
+inline size_t AhoCorasick::bytes() const noexcept {
+  return delta.size() * sizeof(std::uint32_t) + output.size() * sizeof(std::uint32_t) +
+         depth.size() * sizeof(std::uint16_t) + words.size() * sizeof(std::uint64_t);
+}
+
+/**
+ * @brief Reports every occurrence of every dictionary word in a text.
+ *
+ * Occurrences are reported by end position; occurrences ending at the same position come longest first.
+ *
+ * @param text Text to scan.
+ * @param on_match Called as on_match(begin, length) for each occurrence.
+ */
+template <typename Callback>
+inline void AhoCorasick::report(const std::uint32_t row, const size_t end, Callback& on_match) const {
+  const std::uint32_t state = row / width;
+  for (std::uint32_t match = isWord(state) ? state : output[state]; match != kNone; match = output[match]) {
+    on_match(end - depth[match], static_cast<size_t>(depth[match]));
+  }
+}
+
+template <typename Callback>
+inline void AhoCorasick::scan(const std::string_view text, Callback&& on_match) const {
+  std::uint32_t row = 0;
+  for (size_t end = 1; end <= text.size(); ++end) {
+    const std::uint32_t entry = delta[row + classes[static_cast<unsigned char>(text[end - 1])]];
+    row = entry & ~kReports;
+    if ((entry & kReports) != 0) {
+      report(row, end, on_match);
+    }
+  }
+}
+
+/**
+ * @brief Counts the occurrences of dictionary words in a text.
+ *
+ * A single scan waits for one table load per character. Since counting needs no particular
+ * order, the text is cut into kLanes segments that are scanned in lockstep, so their loads
+ * overlap. Each segment but the first starts from the root `longest` characters early, which is
+ * enough to reach the exact state at its first character; matches ending in that lead-in belong
+ * to the previous segment and are not counted.
+ *
+ * @param text Text to scan.
+ * @return Number of (position, word) occurrences, overlapping ones included.
+ */
+inline size_t AhoCorasick::count(const std::string_view text) const {
+  size_t matches = 0;
+  const auto counter = [&](size_t, size_t) { ++matches; };
+  const size_t segment = text.size() / kLanes;
+  if (segment <= longest) {
+    scan(text, counter);
+    return matches;
+  }
+
+  const auto step = [&](const std::uint32_t row, const size_t position) {
+    return delta[row + classes[static_cast<unsigned char>(text[position])]];
+  };
+  std::array<std::uint32_t, kLanes> rows{};
+  for (size_t lead = longest; lead > 0; --lead) {
+    for (size_t lane = 1; lane < kLanes; ++lane) {
+      rows[lane] = step(rows[lane], lane * segment - lead) & ~kReports;
+    }
+  }
+  for (size_t offset = 0; offset < segment; ++offset) {
+    for (size_t lane = 0; lane < kLanes; ++lane) {
+      const size_t position = lane * segment + offset;
+      const std::uint32_t entry = step(rows[lane], position);
+      rows[lane] = entry & ~kReports;
+      if ((entry & kReports) != 0) {
+        report(rows[lane], position + 1, counter);
+      }
+    }
+  }
+  for (size_t position = kLanes * segment; position < text.size(); ++position) {
+    const std::uint32_t entry = step(rows[kLanes - 1], position);
+    rows[kLanes - 1] = entry & ~kReports;
+    if ((entry & kReports) != 0) {
+      report(rows[kLanes - 1], position + 1, counter);
+    }
+  }
+  return matches;
+}
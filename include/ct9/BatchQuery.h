@@ -0,0 +1,261 @@
+#pragma once
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Read-only view of a whole file, memory-mapped where possible.
+ *
+ * Regular files are mapped; anything that cannot be mapped (a pipe, an empty file) is read into
+ * memory once instead, so callers always get one contiguous string_view.
+ */
+class MappedFile final {
+public:
+  explicit MappedFile(const std::string& path);
+  ~MappedFile();
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  [[nodiscard]] bool isOpen() const noexcept { return open; }
+  [[nodiscard]] std::string_view view() const noexcept {
+    return mapping != nullptr ? std::string_view(static_cast<const char*>(mapping), length) : std::string_view(copy);
+  }
+
+private:
+  void* mapping{nullptr};
+  size_t length{0};
+  std::string copy;
+  bool open{false};
+};
+
+inline MappedFile::MappedFile(const std::string& path) {
+  const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return;
+  }
+  struct stat info{};
+  if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+    void* address = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    if (address != MAP_FAILED) {
+      ::madvise(address, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+      mapping = address;
+      length = static_cast<size_t>(info.st_size);
+    }
+  }
+  ::close(fd);
+  if (mapping == nullptr) {
+    std::ifstream file(path, std::ios::binary);
+    copy.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+  open = true;
+}
+
+inline MappedFile::~MappedFile() {
+  if (mapping != nullptr) {
+    ::munmap(mapping, length);
+  }
+}
+
+/**
+ * @brief Answers a file of queries, one per line, across a pool of threads.
+ *
+ * The input is cut at line boundaries into chunks of about `chunk_bytes`. Worker threads take
+ * chunks in order, answer every line and format the output of the whole chunk into one buffer;
+ * the calling thread writes the buffers out strictly in chunk order with one write() each, so the
+ * output lines follow the input lines. Workers stay at most `window` chunks ahead of the writer,
+ * which bounds the memory held by finished but unwritten output.
+ *
+ * Each output line is the query followed by its answers, separated by tabs.
+ */
+class BatchQuery final {
+public:
+  struct Options final {
+    size_t threads{std::max(1u, std::thread::hardware_concurrency())};
+    size_t chunk_bytes{64 * 1024};
+    size_t window{0};
+  };
+
+  struct Report final {
+    size_t queries{0};
+    double seconds{0};
+    double p50{0};
+    double p90{0};
+    double p99{0};
+    double p999{0};
+    double max{0};
+
+    [[nodiscard]] double throughput() const noexcept { return seconds > 0 ? queries / seconds : 0; }
+  };
+
+  BatchQuery() : BatchQuery(Options{}) {}
+  explicit BatchQuery(Options options) : options(options) {}
+
+  template <typename Answer>
+  Report run(std::string_view input, int output_fd, Answer&& answer) const;
+
+private:
+  struct Chunk final {
+    std::string output;
+    std::vector<float> latencies;
+    bool done{false};
+  };
+
+  [[nodiscard]] std::vector<std::string_view> split(std::string_view input) const;
+  static bool writeAll(int fd, std::string_view data);
+
+  Options options;
+};
+
+/**
+ * @brief Cuts the input into chunks that end right after a newline (or at the end of the input).
+ */
+inline std::vector<std::string_view> BatchQuery::split(const std::string_view input) const {
+  std::vector<std::string_view> chunks;
+  size_t begin = 0;
+  while (begin < input.size()) {
+    size_t end = std::min(input.size(), begin + std::max<size_t>(1, options.chunk_bytes));
+    if (end < input.size()) {
+      const void* newline = std::memchr(input.data() + end - 1, '\n', input.size() - end + 1);
+      end = newline == nullptr ? input.size()
+                               : static_cast<size_t>(static_cast<const char*>(newline) - input.data()) + 1;
+    }
+    chunks.push_back(input.substr(begin, end - begin));
+    begin = end;
+  }
+  return chunks;
+}
+
+inline bool BatchQuery::writeAll(const int fd, const std::string_view data) {
+  size_t written = 0;
+  while (written < data.size()) {
+    const ssize_t result = ::write(fd, data.data() + written, data.size() - written);
+    if (result < 0) {
+      return false;
+    }
+    written += static_cast<size_t>(result);
+  }
+  return true;
+}
+
+/**
+ * @brief Answers every line of the input and writes the results in input order.
+ *
+ * @param input Queries, one per line; a trailing '\r' is dropped.
+ * @param output_fd Where the results go, e.g. STDOUT_FILENO.
+ * @param answer Called as answer(query) from several threads at once; returns a
+ *               std::queue<std::string>. It must only read shared state.
+ * @return Query count, wall time and per-query latency percentiles in microseconds.
+ */
+template <typename Answer>
+inline BatchQuery::Report BatchQuery::run(const std::string_view input, const int output_fd, Answer&& answer) const {
+  const auto start = std::chrono::steady_clock::now();
+  const std::vector<std::string_view> pieces = split(input);
+  const size_t threads = std::max<size_t>(1, options.threads);
+  const size_t window = options.window > 0 ? options.window : 4 * threads;
+
+  std::vector<Chunk> chunks(pieces.size());
+  std::mutex mutex;
+  std::condition_variable produced;
+  std::condition_variable consumed;
+  size_t next = 0;
+  size_t written = 0;
+
+  const auto work = [&] {
+    while (true) {
+      size_t index = 0;
+      {
+        std::unique_lock lock(mutex);
+        consumed.wait(lock, [&] { return next >= pieces.size() || next < written + window; });
+        if (next >= pieces.size()) {
+          return;
+        }
+        index = next++;
+      }
+
+      Chunk& chunk = chunks[index];
+      std::string_view rest = pieces[index];
+      std::string query;
+      while (!rest.empty()) {
+        const size_t newline = rest.find('\n');
+        std::string_view line = rest.substr(0, newline);
+        rest.remove_prefix(newline == std::string_view::npos ? rest.size() : newline + 1);
+        if (!line.empty() && line.back() == '\r') {
+          line.remove_suffix(1);
+        }
+
+        query.assign(line);
+        const auto asked = std::chrono::steady_clock::now();
+        std::queue<std::string> words = answer(query);
+        chunk.latencies.push_back(
+            std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - asked).count());
+
+        chunk.output += query;
+        while (!words.empty()) {
+          chunk.output += '\t';
+          chunk.output += words.front();
+          words.pop();
+        }
+        chunk.output += '\n';
+      }
+
+      {
+        std::lock_guard lock(mutex);
+        chunk.done = true;
+      }
+      produced.notify_all();
+    }
+  };
+
+  std::vector<std::thread> pool;
+  pool.reserve(threads);
+  for (size_t i = 0; i < threads; ++i) {
+    pool.emplace_back(work);
+  }
+
+  std::vector<float> latencies;
+  for (size_t index = 0; index < chunks.size(); ++index) {
+    std::string output;
+    {
+      std::unique_lock lock(mutex);
+      produced.wait(lock, [&] { return chunks[index].done; });
+      output = std::move(chunks[index].output);
+      written = index + 1;
+    }
+    consumed.notify_all();
+    static_cast<void>(writeAll(output_fd, output));
+    latencies.insert(latencies.end(), chunks[index].latencies.begin(), chunks[index].latencies.end());
+    std::vector<float>().swap(chunks[index].latencies);
+  }
+  for (std::thread& thread : pool) {
+    thread.join();
+  }
+
+  Report report;
+  report.queries = latencies.size();
+  report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  if (!latencies.empty()) {
+    std::sort(latencies.begin(), latencies.end());
+    const auto at = [&](const double p) { return latencies[static_cast<size_t>(p * (latencies.size() - 1))]; };
+    report.p50 = at(0.5);
+    report.p90 = at(0.9);
+    report.p99 = at(0.99);
+    report.p999 = at(0.999);
+    report.max = latencies.back();
+  }
+  return report;
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Blocked Bloom filter: every key sets and tests bits of a single 64-byte block.
+ *
+ * A lookup therefore touches one cache line, unlike a classic Bloom filter whose probes are
+ * spread over the whole bit array. It answers "definitely absent" or "maybe present"; the false
+ * positive rate is about 1% at the default 10 bits per key. Keys cannot be removed, the owner
+ * rebuilds the filter when too many stored keys are gone.
+ */
+class BlockedBloomFilter final {
+public:
+  static constexpr size_t kBitsPerKey = 10;
+
+  explicit BlockedBloomFilter(size_t capacity = 1024);
+
+  void insert(std::string_view key);
+  [[nodiscard]] bool mayContain(std::string_view key) const;
+  void clear();
+
+  [[nodiscard]] size_t capacity() const noexcept { return blocks.size() * kBlockBits / kBitsPerKey; }
+  [[nodiscard]] size_t bytes() const noexcept { return blocks.size() * sizeof(Block); }
+
+private:
+  static constexpr size_t kBlockBits = 512;
+  static constexpr int kProbes = 7;
+
+  struct alignas(64) Block final {
+    std::uint64_t words[kBlockBits / 64];
+  };
+
+  [[nodiscard]] static std::uint64_t hash(std::string_view key) noexcept;
+  [[nodiscard]] size_t blockOf(std::uint64_t hash) const noexcept;
+
+  std::vector<Block> blocks;
+};
+
+/**
+ * @brief Creates an empty filter sized for `capacity` keys.
+ * @param capacity Expected number of keys.
+ */
+inline BlockedBloomFilter::BlockedBloomFilter(const size_t capacity)
+    : blocks(std::max<size_t>(1, (capacity * kBitsPerKey + kBlockBits - 1) / kBlockBits)) {}
+
+/**
+ * @brief Hash of a key with its bits mixed, so that both halves can be used independently.
+ */
+inline std::uint64_t BlockedBloomFilter::hash(const std::string_view key) noexcept {
+  std::uint64_t value = std::hash<std::string_view>{}(key);
+  value ^= value >> 33;
+  value *= 0xff51afd7ed558ccdULL;
+  value ^= value >> 33;
+  return value;
+}
+
+/**
+ * @brief Block of a key: the high half of the hash scaled to the number of blocks.
+ */
+inline size_t BlockedBloomFilter::blockOf(const std::uint64_t hash) const noexcept {
+  return static_cast<size_t>(((hash >> 32) * blocks.size()) >> 32);
+}
+
+/**
+ * @brief Adds a key.
+ * @param key Key to add.
+ */
+inline void BlockedBloomFilter::insert(const std::string_view key) {
+  const std::uint64_t value = hash(key);
+  Block& block = blocks[blockOf(value)];
+  std::uint32_t probe = static_cast<std::uint32_t>(value);
+  for (int i = 0; i < kProbes; ++i) {
+    block.words[(probe >> 6) % (kBlockBits / 64)] |= std::uint64_t{1} << (probe & 63);
+    probe = std::rotl(probe, 9) * 0x9e3779b1u;
+  }
+}
+
+/**
+ * @brief Tests a key.
+ * @param key Key to look up.
+ * @return false if the key was never inserted; true if it probably was.
+ */
+inline bool BlockedBloomFilter::mayContain(const std::string_view key) const {
+  const std::uint64_t value = hash(key);
+  const Block& block = blocks[blockOf(value)];
+  std::uint32_t probe = static_cast<std::uint32_t>(value);
+  for (int i = 0; i < kProbes; ++i) {
+    if ((block.words[(probe >> 6) % (kBlockBits / 64)] & (std::uint64_t{1} << (probe & 63))) == 0) {
+      return false;
+    }
+    probe = std::rotl(probe, 9) * 0x9e3779b1u;
+  }
+  return true;
+}
+
+/**
+ * @brief Removes every key.
+ */
+inline void BlockedBloomFilter::clear() {
+  std::fill(blocks.begin(), blocks.end(), Block{});
+}
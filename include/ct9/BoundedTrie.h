@@ -0,0 +1,162 @@
+#pragma once
+#include <climits>
+#include <cstddef>
+#include <map>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Trie.h"
+
+/**
+ * @brief Trie with a memory budget: once it is exceeded, words nobody read recently are evicted.
+ *
+ * Every read through contain() or autocomplete() sets the CLOCK bit of the words it returns. When
+ * an insertion takes the estimated size past the budget, BasicTrie::sweep() moves a hand over the
+ * words, clearing set bits and collecting words whose bit was already clear, and those are
+ * removed with BasicTrie::del(), which also prunes their dead branches. Eviction goes down to
+ * 15/16 of the budget, so it runs in batches rather than on every insertion.
+ *
+ * The size is tracked as a node count times kNodeBytes, an estimate of one node with its
+ * allocator overhead and, for std::map children, the map entry that points to it.
+ */
+template <typename Alphabet = CharAlphabet>
+class BasicBoundedTrie final {
+  using Node = std::remove_pointer_t<decltype(std::declval<const BasicTrie<Alphabet>&>().getRoot())>;
+
+  [[nodiscard]] static constexpr size_t chunk(const size_t bytes) { return (bytes + 8 + 15) / 16 * 16; }
+
+public:
+  static constexpr size_t kNodeBytes =
+      chunk(sizeof(Node)) +
+      (std::is_same_v<typename Alphabet::template Children<Node>, std::map<char, Node*>>
+           ? chunk(4 * sizeof(void*) + sizeof(std::pair<const char, Node*>))
+           : 0);
+
+  explicit BasicBoundedTrie(size_t budget_bytes) : budget(budget_bytes) {}
+
+  void insert(const std::string& text);
+  void del(const std::string& word);
+  [[nodiscard]] bool contain(const std::string& word) const { return trie.contain(word); }
+  [[nodiscard]] std::queue<std::string> autocomplete(const std::string& prefix, size_t count = INT_MAX) const {
+    return trie.autocomplete(prefix, count);
+  }
+
+  [[nodiscard]] size_t bytes() const noexcept { return nodes * kNodeBytes; }
+  [[nodiscard]] size_t limit() const noexcept { return budget; }
+  [[nodiscard]] size_t evicted() const noexcept { return evictions; }
+  [[nodiscard]] const BasicTrie<Alphabet>& words() const noexcept { return trie; }
+
+private:
+  static constexpr size_t kSweepBatch = 64;
+
+  void add(const std::string& word);
+  void remove(const std::string& word);
+  void evict();
+
+  BasicTrie<Alphabet> trie;
+  size_t budget;
+  size_t nodes{1};
+  size_t evictions{0};
+  std::string hand;
+};
+
+using BoundedTrie = BasicBoundedTrie<CharAlphabet>;
+
+/**
+ * @brief Inserts text, then evicts cold words if the budget is exceeded.
+ *
+ * Splits the text at characters outside of the alphabet exactly like BasicTrie::insert().
+ * A word just inserted starts with a clear bit, so it survives only if it is read before the
+ * hand comes around.
+ *
+ * @param text A single word or several words separated by non-alphabet characters.
+ */
+template <typename Alphabet>
+inline void BasicBoundedTrie<Alphabet>::insert(const std::string& text) {
+  size_t start = 0;
+  for (size_t i = 0; i <= text.size(); ++i) {
+    if (i < text.size() && Alphabet::contains(text[i])) {
+      continue;
+    }
+    add(text.substr(start, i - start));
+    start = i + 1;
+  }
+  if (bytes() > budget) {
+    evict();
+  }
+}
+
+/**
+ * @brief Inserts one word and counts the nodes it creates: those past the deepest existing node of its path.
+ */
+template <typename Alphabet>
+inline void BasicBoundedTrie<Alphabet>::add(const std::string& word) {
+  const Node* node = trie.getRoot();
+  size_t depth = 0;
+  for (; depth < word.size(); ++depth) {
+    const auto child = node->children.find(word[depth]);
+    if (child == node->children.end()) {
+      break;
+    }
+    node = child->second;
+  }
+  trie.insert(word);
+  nodes += word.size() - depth;
+}
+
+/**
+ * @brief Removes a word from the trie.
+ * @param word The word to be removed.
+ */
+template <typename Alphabet>
+inline void BasicBoundedTrie<Alphabet>::del(const std::string& word) {
+  if (trie.contain(word)) {
+    remove(word);
+  }
+}
+
+/**
+ * @brief Deletes a stored word and counts the nodes BasicTrie::del() prunes with it.
+ *
+ * del() frees the nodes below the deepest proper prefix of the word that is the root, a word, or
+ * has another child, unless the word's own node still has children.
+ */
+template <typename Alphabet>
+inline void BasicBoundedTrie<Alphabet>::remove(const std::string& word) {
+  const Node* node = trie.getRoot();
+  size_t kept = 0;
+  for (size_t depth = 0; depth < word.size(); ++depth) {
+    if (node->end_of_word || node->children.size() > 1) {
+      kept = depth;
+    }
+    node = node->children.find(word[depth])->second;
+  }
+  const bool leaf = node->children.empty();
+  trie.del(word);
+  nodes -= leaf ? word.size() - kept : 0;
+}
+
+/**
+ * @brief Deletes cold words, kSweepBatch at a time, until the trie fits in 15/16 of its budget.
+ */
+template <typename Alphabet>
+inline void BasicBoundedTrie<Alphabet>::evict() {
+  const size_t target = budget - budget / 16;
+  while (bytes() > target) {
+    const std::vector<std::string> victims = trie.sweep(hand, kSweepBatch);
+    if (victims.empty()) {
+      break;
+    }
+    for (const std::string& victim : victims) {
+      remove(victim);
+      ++evictions;
+      if (bytes() <= target) {
+        break;
+      }
+    }
+  }
+}
@@ -0,0 +1,138 @@
+#pragma once
+#include <climits>
+#include <cstddef>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "BloomFilter.h"
+#include "Trie.h"
+
+/**
+ * @brief Trie with a blocked Bloom filter in front of it for fast negative lookups.
+ *
+ * contain() asks the filter first, so most absent words are rejected after reading one cache line
+ * instead of walking the trie. insert() always descends: re-inserting a stored word costs the same
+ * walk as checking for it, so the filter cannot save work there and only counts the new words.
+ *
+ * A Bloom filter cannot forget keys, so del() only counts the removals; once a quarter of the keys
+ * in the filter are gone, or the trie has outgrown the filter, the filter is rebuilt from the trie.
+ */
+template <typename Alphabet = CharAlphabet>
+class BasicFilteredTrie final {
+public:
+  BasicFilteredTrie() = default;
+  explicit BasicFilteredTrie(const std::vector<std::string>& words);
+
+  void insert(const std::string& text);
+  void del(const std::string& word);
+  [[nodiscard]] bool contain(const std::string& word) const;
+  [[nodiscard]] std::queue<std::string> autocomplete(const std::string& prefix, size_t count = INT_MAX) const {
+    return trie.autocomplete(prefix, count);
+  }
+
+  void rebuild();
+  [[nodiscard]] const BasicTrie<Alphabet>& words() const noexcept { return trie; }
+  [[nodiscard]] const BlockedBloomFilter& filter() const noexcept { return bloom; }
+
+private:
+  void add(const std::string& word);
+
+  BasicTrie<Alphabet> trie;
+  BlockedBloomFilter bloom;
+  size_t stored{0};
+  size_t deleted{0};
+};
+
+using FilteredTrie = BasicFilteredTrie<CharAlphabet>;
+
+/**
+ * @brief Creates a trie holding the given words, with a filter sized for them.
+ * @param words Words to insert.
+ */
+template <typename Alphabet>
+inline BasicFilteredTrie<Alphabet>::BasicFilteredTrie(const std::vector<std::string>& words)
+    : bloom(words.size()) {
+  for (const std::string& word : words) {
+    insert(word);
+  }
+}
+
+/**
+ * @brief Inserts text into the trie and its words into the filter.
+ *
+ * Splits the text at characters outside of the alphabet exactly like BasicTrie::insert().
+ *
+ * @param text A single word or several words separated by non-alphabet characters.
+ */
+template <typename Alphabet>
+inline void BasicFilteredTrie<Alphabet>::insert(const std::string& text) {
+  size_t start = 0;
+  for (size_t i = 0; i <= text.size(); ++i) {
+    if (i < text.size() && Alphabet::contains(text[i])) {
+      continue;
+    }
+    add(text.substr(start, i - start));
+    start = i + 1;
+  }
+}
+
+/**
+ * @brief Inserts one word; grows the filter when it is full.
+ *
+ * Words the filter has not seen are counted as new. Words it only may have seen are not, so the
+ * count misses the odd false positive, which is fine for deciding when to rebuild.
+ */
+template <typename Alphabet>
+inline void BasicFilteredTrie<Alphabet>::add(const std::string& word) {
+  trie.insert(word);
+  if (bloom.mayContain(word)) {
+    return;
+  }
+  bloom.insert(word);
+  if (++stored > bloom.capacity()) {
+    rebuild();
+  }
+}
+
+/**
+ * @brief Removes a word from the trie.
+ * @param word The word to be removed.
+ */
+template <typename Alphabet>
+inline void BasicFilteredTrie<Alphabet>::del(const std::string& word) {
+  if (!contain(word)) {
+    return;
+  }
+  trie.del(word);
+  stored -= stored > 0 ? 1 : 0;
+  ++deleted;
+  if (deleted * 4 > stored + deleted) {
+    rebuild();
+  }
+}
+
+/**
+ * @brief Checks if a given word exists in the trie.
+ * @param word The word to search for.
+ * @return true if the word is stored; the trie is only walked when the filter cannot rule it out.
+ */
+template <typename Alphabet>
+inline bool BasicFilteredTrie<Alphabet>::contain(const std::string& word) const {
+  return bloom.mayContain(word) && trie.contain(word);
+}
+
+/**
+ * @brief Builds a new filter from the words of the trie, with room for twice as many.
+ */
+template <typename Alphabet>
+inline void BasicFilteredTrie<Alphabet>::rebuild() {
+  std::queue<std::string> all = trie.autocomplete("", INT_MAX);
+  bloom = BlockedBloomFilter(2 * all.size());
+  stored = all.size();
+  deleted = 0;
+  while (!all.empty()) {
+    bloom.insert(all.front());
+    all.pop();
+  }
+}
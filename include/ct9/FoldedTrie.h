@@ -0,0 +1,196 @@
+#pragma once
+#include <climits>
+#include <cstddef>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Trie.h"
+
+/**
+ * @brief Case- and accent-insensitive trie that still suggests words as they were written.
+ *
+ * Every word is stored under its folded key: ASCII letters are lowercased and the Latin letters of
+ * UTF-8 U+00C0..U+017F lose their accents ("Café" becomes "cafe", "Straße" becomes "strasse").
+ * The spellings seen for a key are kept on its end-of-word node, see BasicTrie::insert_form(), so
+ * "Apple", "apple" and "APPLE" take one path instead of three and autocomplete() finds all of them
+ * in a single walk. Any other character separates words, as in BasicTrie::insert().
+ *
+ * words() exposes the trie of keys; diff(), replication and the set operators carry keys only.
+ */
+template <typename Alphabet = CharAlphabet>
+class BasicFoldedTrie final {
+public:
+  BasicFoldedTrie() = default;
+  explicit BasicFoldedTrie(const std::vector<std::string>& texts);
+
+  void insert(std::string_view text);
+  bool del(std::string_view word);
+  [[nodiscard]] bool contain(std::string_view word) const;
+  [[nodiscard]] std::queue<std::string> autocomplete(std::string_view prefix, size_t count = INT_MAX) const;
+  [[nodiscard]] const BasicTrie<Alphabet>& words() const noexcept { return trie; }
+
+  [[nodiscard]] static std::string fold(std::string_view text);
+
+private:
+  static size_t foldLetter(std::string_view text, size_t index, std::string& key);
+
+  BasicTrie<Alphabet> trie;
+};
+
+using FoldedTrie = BasicFoldedTrie<CharAlphabet>;
+
+/**
+ * @brief Creates a trie holding the words of the given texts.
+ * @param texts Words, or texts of several words.
+ */
+template <typename Alphabet>
+inline BasicFoldedTrie<Alphabet>::BasicFoldedTrie(const std::vector<std::string>& texts) {
+  for (const std::string& text : texts) {
+    insert(text);
+  }
+}
+
+/**
+ * @brief Folds the letter at `index` onto `key`.
+ * @return Bytes the letter takes in `text`, or 0 if no letter starts there.
+ */
+template <typename Alphabet>
+inline size_t BasicFoldedTrie<Alphabet>::foldLetter(const std::string_view text, const size_t index,
+                                                     std::string& key) {
+  // Base letters of U+00C0..U+017F; '*' stands for two letters, '.' for a symbol.
+  static constexpr std::string_view kLatin =
+      "aaaaaa*ceeeeiiiidnooooo.ouuuuy**aaaaaa*ceeeeiiiidnooooo.ouuuuy*y"
+      "aaaaaaccccccccddddeeeeeeeeeegggggggghhhhiiiiiiiiii**jjkkklllllll"
+      "lllnnnnnnnnnoooooo**rrrrrrssssssssttttttuuuuuuuuuuuuwwyyyzzzzzzs";
+  static_assert(kLatin.size() == 0x180 - 0xC0);
+  const char character = text[index];
+  if (character >= 'A' && character <= 'Z') {
+    key.push_back(static_cast<char>(character - 'A' + 'a'));
+    return 1;
+  }
+  if (character >= 'a' && character <= 'z') {
+    key.push_back(character);
+    return 1;
+  }
+
+  const auto lead = static_cast<unsigned char>(character);
+  if (lead < 0xC3 || lead > 0xC5 || index + 1 >= text.size() ||
+      (static_cast<unsigned char>(text[index + 1]) & 0xC0) != 0x80) {
+    return 0;
+  }
+  const unsigned code = (lead & 0x1Fu) << 6 | (static_cast<unsigned char>(text[index + 1]) & 0x3Fu);
+  const char base = kLatin[code - 0xC0];
+  if (base == '.') {
+    return 0;
+  }
+  if (base != '*') {
+    key.push_back(base);
+    return 2;
+  }
+  switch (code) {
+    case 0xC6:
+    case 0xE6:
+      key += "ae";
+      break;
+    case 0xDE:
+    case 0xFE:
+      key += "th";
+      break;
+    case 0xDF:
+      key += "ss";
+      break;
+    case 0x132:
+    case 0x133:
+      key += "ij";
+      break;
+    default:  // U+0152, U+0153
+      key += "oe";
+      break;
+  }
+  return 2;
+}
+
+/**
+ * @brief The key a word is stored under.
+ *
+ * Characters that are not letters are kept as they are, so a text of several words folds to a
+ * string that is not a key.
+ *
+ * @param text A word or a prefix.
+ * @return The folded text.
+ */
+template <typename Alphabet>
+inline std::string BasicFoldedTrie<Alphabet>::fold(const std::string_view text) {
+  std::string key;
+  key.reserve(text.size());
+  for (size_t i = 0; i < text.size();) {
+    const size_t length = foldLetter(text, i, key);
+    if (length == 0) {
+      key.push_back(text[i]);
+    }
+    i += length == 0 ? 1 : length;
+  }
+  return key;
+}
+
+/**
+ * @brief Inserts every word of a text, keeping its spelling.
+ * @param text A single word or several words separated by characters that are not letters.
+ */
+template <typename Alphabet>
+inline void BasicFoldedTrie<Alphabet>::insert(const std::string_view text) {
+  std::string key;
+  size_t start = 0;
+  for (size_t i = 0; i <= text.size();) {
+    const size_t length = i < text.size() ? foldLetter(text, i, key) : 0;
+    if (length > 0) {
+      i += length;
+      continue;
+    }
+    if (!key.empty()) {
+      trie.insert_form(key, text.substr(start, i - start));
+      key.clear();
+    }
+    start = ++i;
+  }
+}
+
+/**
+ * @brief Removes one spelling of a word; the other spellings of the same key stay.
+ * @param word The spelling to remove, exactly as it was inserted.
+ * @return true if the spelling was stored.
+ */
+template <typename Alphabet>
+inline bool BasicFoldedTrie<Alphabet>::del(const std::string_view word) {
+  return trie.erase_form(fold(word), word);
+}
+
+/**
+ * @brief Checks if any spelling of a word is stored.
+ * @param word The word in any case and with or without accents.
+ */
+template <typename Alphabet>
+inline bool BasicFoldedTrie<Alphabet>::contain(const std::string_view word) const {
+  return trie.contain(fold(word));
+}
+
+/**
+ * @brief Words that start with a prefix in any case and with any accents, as they were written.
+ *
+ * An incomplete UTF-8 sequence at the end of the prefix is ignored, so the suggestions do not go
+ * blank while the second byte of an accented letter is still being typed.
+ *
+ * @param prefix The prefix to search for.
+ * @param count The maximum number of spellings to return.
+ * @return Spellings in lexicographical order of their keys.
+ */
+template <typename Alphabet>
+inline std::queue<std::string> BasicFoldedTrie<Alphabet>::autocomplete(std::string_view prefix,
+                                                                        const size_t count) const {
+  if (!prefix.empty() && (static_cast<unsigned char>(prefix.back()) & 0xC0) == 0xC0) {
+    prefix.remove_suffix(1);
+  }
+  return trie.autocomplete_forms(fold(prefix), count);
+}
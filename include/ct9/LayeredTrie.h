@@ -0,0 +1,264 @@
+#pragma once
+#include <algorithm>
+#include <climits>
+#include <memory>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Trie.h"
+
+/**
+ * @brief Read-through view over a stack of tries, queried without merging them.
+ *
+ * The bottom layers are shared, read-only tries (for example one system dictionary used by
+ * thousands of sessions); the top layer belongs to the view and receives insert() and del().
+ * Every layer has a word trie and a tombstone trie. A word is visible if the highest layer that
+ * mentions it has it as a word; a tombstone hides the word in every layer below.
+ *
+ * autocomplete() walks all layers in lockstep: at each step the children of the current nodes of
+ * every layer are merged in key order, so results come out lexicographically without building
+ * or copying a merged trie.
+ */
+template <typename Alphabet = CharAlphabet>
+class BasicLayeredTrie final {
+  using Layer = std::pair<std::shared_ptr<const BasicTrie<Alphabet>>, std::shared_ptr<const BasicTrie<Alphabet>>>;
+  using Node = std::remove_pointer_t<decltype(std::declval<const BasicTrie<Alphabet>&>().getRoot())>;
+
+public:
+  explicit BasicLayeredTrie(std::shared_ptr<const BasicTrie<Alphabet>> base);
+
+  void push(std::shared_ptr<const BasicTrie<Alphabet>> words,
+            std::shared_ptr<const BasicTrie<Alphabet>> tombstones = nullptr);
+  void insert(const std::string& word);
+  void del(const std::string& word);
+
+  [[nodiscard]] bool contain(const std::string& word) const;
+  [[nodiscard]] std::queue<std::string> autocomplete(const std::string& prefix, size_t count = INT_MAX) const;
+  [[nodiscard]] size_t layers() const noexcept { return shared.size() + 1; }
+
+private:
+  [[nodiscard]] std::vector<const Node*> roots() const;
+  static void descend(std::vector<const Node*>& cursor, std::string_view path);
+  [[nodiscard]] static bool visible(const std::vector<const Node*>& cursor);
+  static void collect(std::vector<const Node*> cursor, std::string& current, std::queue<std::string>& results,
+                      size_t count);
+
+  std::vector<Layer> shared;
+  BasicTrie<Alphabet> own_words;
+  BasicTrie<Alphabet> own_tombstones;
+};
+
+using LayeredTrie = BasicLayeredTrie<CharAlphabet>;
+
+/**
+ * @brief Creates a view with a shared base dictionary and an empty private layer on top.
+ * @param base Bottom layer.
+ */
+template <typename Alphabet>
+inline BasicLayeredTrie<Alphabet>::BasicLayeredTrie(std::shared_ptr<const BasicTrie<Alphabet>> base) {
+  shared.emplace_back(std::move(base), nullptr);
+}
+
+/**
+ * @brief Adds a shared layer above the existing shared layers, below the private one.
+ * @param words Words of the layer.
+ * @param tombstones Words the layer hides from the layers below, may be null.
+ */
+template <typename Alphabet>
+inline void BasicLayeredTrie<Alphabet>::push(std::shared_ptr<const BasicTrie<Alphabet>> words,
+                                             std::shared_ptr<const BasicTrie<Alphabet>> tombstones) {
+  shared.emplace_back(std::move(words), std::move(tombstones));
+}
+
+/**
+ * @brief Adds a word to the private layer and lifts a tombstone for it, if any.
+ * @param word A single word.
+ */
+template <typename Alphabet>
+inline void BasicLayeredTrie<Alphabet>::insert(const std::string& word) {
+  own_words.insert(word);
+  own_tombstones.del(word);
+}
+
+/**
+ * @brief Hides a word: removes it from the private layer and tombstones it if a shared layer has it.
+ * @param word A single word.
+ */
+template <typename Alphabet>
+inline void BasicLayeredTrie<Alphabet>::del(const std::string& word) {
+  own_words.del(word);
+  own_tombstones.del(word);
+  if (contain(word)) {
+    own_tombstones.insert(word);
+  }
+}
+
+/**
+ * @brief Current node of every trie, top layer first: words and tombstones alternate.
+ */
+template <typename Alphabet>
+inline std::vector<const typename BasicLayeredTrie<Alphabet>::Node*> BasicLayeredTrie<Alphabet>::roots() const {
+  std::vector<const Node*> cursor;
+  cursor.reserve(2 * layers());
+  cursor.push_back(own_words.getRoot());
+  cursor.push_back(own_tombstones.getRoot());
+  for (auto layer = shared.rbegin(); layer != shared.rend(); ++layer) {
+    cursor.push_back(layer->first ? layer->first->getRoot() : nullptr);
+    cursor.push_back(layer->second ? layer->second->getRoot() : nullptr);
+  }
+  return cursor;
+}
+
+/**
+ * @brief Moves every layer's node along the same path; layers without the path become null.
+ */
+template <typename Alphabet>
+inline void BasicLayeredTrie<Alphabet>::descend(std::vector<const Node*>& cursor, const std::string_view path) {
+  for (const char character : path) {
+    for (const Node*& node : cursor) {
+      if (node != nullptr) {
+        const auto child = node->children.find(character);
+        node = child == node->children.end() ? nullptr : child->second;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Resolves whether the key spelled by the cursor is a visible word.
+ * @param cursor Nodes of every layer for the same key, null where the layer has no such path.
+ */
+template <typename Alphabet>
+inline bool BasicLayeredTrie<Alphabet>::visible(const std::vector<const Node*>& cursor) {
+  for (size_t i = 0; i < cursor.size(); i += 2) {
+    if (cursor[i] != nullptr && cursor[i]->end_of_word) {
+      return true;
+    }
+    if (cursor[i + 1] != nullptr && cursor[i + 1]->end_of_word) {
+      return false;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Checks if a word is visible through the layers.
+ * @param word The word to search for.
+ * @return true if the highest layer that mentions the word has it as a word.
+ */
+template <typename Alphabet>
+inline bool BasicLayeredTrie<Alphabet>::contain(const std::string& word) const {
+  std::vector<const Node*> cursor = roots();
+  descend(cursor, word);
+  return visible(cursor);
+}
+
+/**
+ * @brief Provides autocomplete suggestions from all layers at once.
+ * @param prefix The prefix string to search for.
+ * @param count The maximum number of autocomplete suggestions to return.
+ * @return Visible words starting with `prefix`, in lexicographical order.
+ */
+template <typename Alphabet>
+inline std::queue<std::string> BasicLayeredTrie<Alphabet>::autocomplete(const std::string& prefix,
+                                                                        const size_t count) const {
+  std::queue<std::string> results;
+  std::vector<const Node*> cursor = roots();
+  descend(cursor, prefix);
+
+  std::string current = prefix;
+  if (count > 0) {
+    collect(std::move(cursor), current, results, count);
+  }
+  return results;
+}
+
+/**
+ * @brief Lockstep DFS over one key in every layer.
+ *
+ * Child keys of the word tries are merged and visited in order; tombstone tries are only
+ * followed where some word trie continues, since they can hide words but never add any.
+ * Once a single trie remains, its own autocomplete finishes the subtree. The path is kept on
+ * an explicit stack, one cursor and its merged keys per level.
+ *
+ * @param cursor Nodes of every layer at the key in `current`.
+ * @param current The key the cursor stands at; restored on return.
+ * @param results Output queue.
+ * @param count The maximum number of words to collect.
+ */
+template <typename Alphabet>
+inline void BasicLayeredTrie<Alphabet>::collect(std::vector<const Node*> cursor, std::string& current,
+                                                std::queue<std::string>& results, const size_t count) {
+  struct Frame final {
+    std::vector<const Node*> cursor;
+    std::vector<char> keys;
+    size_t next;
+  };
+  std::vector<Frame> stack;
+
+  // Reports the key at `cursor` and queues its children; false once `count` words were collected.
+  const auto enter = [&](std::vector<const Node*> nodes) {
+    std::vector<char> keys;
+    // Below the point where the layers diverge usually only one word trie is left: hand it over.
+    const auto present = [](const Node* node) { return node != nullptr; };
+    if (std::count_if(nodes.begin(), nodes.end(), present) == 1) {
+      const size_t only = static_cast<size_t>(std::find_if(nodes.begin(), nodes.end(), present) - nodes.begin());
+      if (only % 2 == 0) {
+        std::queue<std::string> words = nodes[only]->autocompleteNode(current, count - results.size());
+        while (!words.empty()) {
+          results.push(std::move(words.front()));
+          words.pop();
+        }
+      }
+    } else {
+      if (visible(nodes)) {
+        results.push(current);
+      }
+      for (size_t i = 0; i < nodes.size(); i += 2) {
+        if (nodes[i] != nullptr) {
+          for (const auto& [key, child] : nodes[i]->children) {
+            keys.push_back(key);
+          }
+        }
+      }
+      std::sort(keys.begin(), keys.end());
+      keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    }
+    stack.push_back({std::move(nodes), std::move(keys), 0});
+    return results.size() < count;
+  };
+
+  const size_t depth = current.size();
+  if (!enter(std::move(cursor))) {
+    return;
+  }
+  while (!stack.empty()) {
+    Frame& frame = stack.back();
+    if (frame.next == frame.keys.size()) {
+      stack.pop_back();
+      if (!stack.empty()) {
+        current.pop_back();
+      }
+      continue;
+    }
+    const char key = frame.keys[frame.next++];
+    std::vector<const Node*> next(frame.cursor.size(), nullptr);
+    for (size_t i = 0; i < frame.cursor.size(); ++i) {
+      if (frame.cursor[i] != nullptr) {
+        const auto child = frame.cursor[i]->children.find(key);
+        if (child != frame.cursor[i]->children.end()) {
+          next[i] = child->second;
+        }
+      }
+    }
+    current.push_back(key);
+    if (!enter(std::move(next))) {
+      break;
+    }
+  }
+  current.resize(depth);
+}
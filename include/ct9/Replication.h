@@ -0,0 +1,354 @@
+#pragma once
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Trie.h"
+
+/**
+ * @brief One step of a replication stream: a delta and the trie digests before and after it.
+ *
+ * Encoded as `'D' | body length (4 bytes, LE) | body | FNV-1a of the body (4 bytes, LE)`, where
+ * the body is `base digest (8) | target digest (8) | insert count | delete count | inserts | deletes`.
+ * Counts and lengths are LEB128 varints. Both word lists are sorted, so they are front-coded: every
+ * word is the length of the prefix it shares with the previous one, then the length of the rest and
+ * the rest itself. Bodies are at most kMaxBody bytes, so a damaged length field cannot make a
+ * reader wait for gigabytes that never come.
+ */
+struct DeltaFrame final {
+  std::uint64_t base{0};
+  std::uint64_t target{0};
+  TrieDelta delta;
+
+  [[nodiscard]] std::string encode() const;
+  [[nodiscard]] static std::optional<DeltaFrame> decode(std::string_view data, size_t& used);
+
+  static constexpr size_t kMaxBody = size_t{1} << 28;
+
+private:
+  static constexpr char kMagic = 'D';
+  static constexpr size_t kHeader = 5;
+  static constexpr size_t kTrailer = 4;
+
+  [[nodiscard]] static std::uint32_t checksum(std::string_view body);
+  static void putVarint(std::string& out, std::uint64_t value);
+  [[nodiscard]] static bool getVarint(std::string_view& in, std::uint64_t& value);
+  static void putFixed(std::string& out, std::uint64_t value, int bytes);
+  [[nodiscard]] static std::uint64_t getFixed(std::string_view in, int bytes);
+  static void putWords(std::string& out, const std::vector<std::string>& words);
+  [[nodiscard]] static bool getWords(std::string_view& in, std::uint64_t count, std::vector<std::string>& words);
+};
+
+inline std::uint32_t DeltaFrame::checksum(const std::string_view body) {
+  std::uint32_t hash = 2166136261u;
+  for (const char character : body) {
+    hash = (hash ^ static_cast<unsigned char>(character)) * 16777619u;
+  }
+  return hash;
+}
+
+inline void DeltaFrame::putVarint(std::string& out, std::uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+inline bool DeltaFrame::getVarint(std::string_view& in, std::uint64_t& value) {
+  value = 0;
+  for (int shift = 0; shift < 64 && !in.empty(); shift += 7) {
+    const auto byte = static_cast<unsigned char>(in.front());
+    in.remove_prefix(1);
+    value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+inline void DeltaFrame::putFixed(std::string& out, const std::uint64_t value, const int bytes) {
+  for (int shift = 0; shift < 8 * bytes; shift += 8) {
+    out.push_back(static_cast<char>((value >> shift) & 0xFFu));
+  }
+}
+
+inline std::uint64_t DeltaFrame::getFixed(const std::string_view in, const int bytes) {
+  std::uint64_t value = 0;
+  for (int i = 0; i < bytes; ++i) {
+    value |= static_cast<std::uint64_t>(static_cast<unsigned char>(in[static_cast<size_t>(i)])) << (8 * i);
+  }
+  return value;
+}
+
+inline void DeltaFrame::putWords(std::string& out, const std::vector<std::string>& words) {
+  std::string_view previous;
+  for (const std::string& word : words) {
+    size_t shared = 0;
+    while (shared < previous.size() && shared < word.size() && previous[shared] == word[shared]) {
+      ++shared;
+    }
+    putVarint(out, shared);
+    putVarint(out, word.size() - shared);
+    out.append(word, shared);
+    previous = word;
+  }
+}
+
+inline bool DeltaFrame::getWords(std::string_view& in, const std::uint64_t count, std::vector<std::string>& words) {
+  std::string previous;
+  for (std::uint64_t i = 0; i < count; ++i) {
+    std::uint64_t shared = 0;
+    std::uint64_t rest = 0;
+    if (!getVarint(in, shared) || !getVarint(in, rest) || shared > previous.size() || rest > in.size()) {
+      return false;
+    }
+    previous.resize(shared);
+    previous.append(in.substr(0, rest));
+    in.remove_prefix(rest);
+    words.push_back(previous);
+  }
+  return true;
+}
+
+/**
+ * @brief Serializes the frame.
+ * @return The frame bytes, ready to be written in one piece.
+ * @throws std::length_error if the body would be larger than kMaxBody.
+ */
+inline std::string DeltaFrame::encode() const {
+  std::string body;
+  putFixed(body, base, 8);
+  putFixed(body, target, 8);
+  putVarint(body, delta.inserts.size());
+  putVarint(body, delta.deletes.size());
+  putWords(body, delta.inserts);
+  putWords(body, delta.deletes);
+  if (body.size() > kMaxBody) {
+    throw std::length_error("DeltaFrame body exceeds kMaxBody");
+  }
+
+  std::string frame;
+  frame.reserve(kHeader + body.size() + kTrailer);
+  frame.push_back(kMagic);
+  putFixed(frame, body.size(), 4);
+  frame += body;
+  putFixed(frame, checksum(body), 4);
+  return frame;
+}
+
+/**
+ * @brief Parses the frame at the start of a buffer.
+ * @param data Bytes read from the stream so far.
+ * @param used Out: bytes taken by the frame; 0 if the buffer does not hold a whole frame yet.
+ * @return The frame, or nothing if it is incomplete (`used` is 0) or corrupt (`used` skips the bad bytes).
+ */
+inline std::optional<DeltaFrame> DeltaFrame::decode(const std::string_view data, size_t& used) {
+  used = 0;
+  if (data.empty()) {
+    return std::nullopt;
+  }
+  if (data.front() != kMagic) {
+    const size_t next = data.find(kMagic, 1);
+    used = next == std::string_view::npos ? data.size() : next;
+    return std::nullopt;
+  }
+  if (data.size() < kHeader) {
+    return std::nullopt;
+  }
+  const size_t length = getFixed(data.substr(1), 4);
+  if (length > kMaxBody) {
+    used = 1;
+    return std::nullopt;
+  }
+  if (data.size() < kHeader + length + kTrailer) {
+    return std::nullopt;
+  }
+  used = kHeader + length + kTrailer;
+
+  std::string_view body = data.substr(kHeader, length);
+  if (getFixed(data.substr(kHeader + length), 4) != checksum(body) || body.size() < 16) {
+    return std::nullopt;
+  }
+  DeltaFrame frame;
+  frame.base = getFixed(body, 8);
+  frame.target = getFixed(body.substr(8), 8);
+  body.remove_prefix(16);
+  std::uint64_t inserts = 0;
+  std::uint64_t deletes = 0;
+  if (!getVarint(body, inserts) || !getVarint(body, deletes) || !getWords(body, inserts, frame.delta.inserts) ||
+      !getWords(body, deletes, frame.delta.deletes)) {
+    return std::nullopt;
+  }
+  return frame;
+}
+
+/**
+ * @brief Leader side of replication: writes what changed in a trie since the last publish() to a file or pipe.
+ *
+ * Keeps a copy of the words it shipped. publish() diffs the live trie against the copy, which skips
+ * unchanged subtrees by their digests, writes the delta as one DeltaFrame and applies it to the
+ * copy. The first frame starts from the empty trie, so a follower reading a file from its start
+ * rebuilds every word.
+ *
+ * A frame that could not be written at all is taken back from the copy, so the next publish()
+ * sends its changes again. A frame cut short (a full non-blocking pipe, a full disk) stays
+ * shipped and its rest is written first by the next publish(), so the stream never holds a torn
+ * frame followed by another one.
+ *
+ * @note publish() fills the digest cache of the live trie, so it runs on the thread that writes it.
+ */
+template <typename Alphabet = CharAlphabet>
+class BasicReplicaPublisher final {
+public:
+  explicit BasicReplicaPublisher(int fd) : fd(fd) {}
+
+  size_t publish(const BasicTrie<Alphabet>& trie);
+  [[nodiscard]] const BasicTrie<Alphabet>& shipped() const noexcept { return copy; }
+
+private:
+  size_t writeSome(std::string_view bytes) const;
+
+  int fd;
+  BasicTrie<Alphabet> copy;
+  std::string unsent;
+};
+
+/**
+ * @brief Writes as much of `bytes` as the descriptor takes now, retrying when interrupted.
+ * @return Bytes written; fewer than asked if the write failed or would block.
+ */
+template <typename Alphabet>
+inline size_t BasicReplicaPublisher<Alphabet>::writeSome(const std::string_view bytes) const {
+  size_t written = 0;
+  while (written < bytes.size()) {
+    const ssize_t result = ::write(fd, bytes.data() + written, bytes.size() - written);
+    if (result < 0 && errno == EINTR) {
+      continue;
+    }
+    if (result <= 0) {
+      break;
+    }
+    written += static_cast<size_t>(result);
+  }
+  return written;
+}
+
+/**
+ * @brief Ships the changes since the previous call, after the rest of a frame cut short before.
+ * @param trie The live trie.
+ * @return Bytes written; 0 if nothing changed or the write failed.
+ * @throws std::length_error if the changes do not fit in one frame, see DeltaFrame::kMaxBody.
+ */
+template <typename Alphabet>
+inline size_t BasicReplicaPublisher<Alphabet>::publish(const BasicTrie<Alphabet>& trie) {
+  const size_t written = writeSome(unsent);
+  unsent.erase(0, written);
+  if (!unsent.empty()) {
+    return written;
+  }
+
+  DeltaFrame frame;
+  frame.delta = copy.diff(trie);
+  if (frame.delta.empty()) {
+    return written;
+  }
+  frame.base = copy.digest();
+  copy.apply(frame.delta);
+  frame.target = copy.digest();
+  const auto revert = [&] { copy.apply(TrieDelta{frame.delta.deletes, frame.delta.inserts}); };
+
+  std::string bytes;
+  try {
+    bytes = frame.encode();
+  } catch (...) {
+    revert();
+    throw;
+  }
+  const size_t sent = writeSome(bytes);
+  if (sent == 0) {
+    revert();
+    return written;
+  }
+  unsent = bytes.substr(sent);
+  return written + sent;
+}
+
+/**
+ * @brief Follower side of replication: applies the frames of a BasicReplicaPublisher to a local trie.
+ *
+ * A frame is applied only if the trie has the frame's base digest. If it does not (the follower
+ * joined a pipe after the first frames, or a frame was damaged) the follower is out of sync and
+ * stays at its last good state; the leader has to be restarted to send everything again.
+ */
+template <typename Alphabet = CharAlphabet>
+class BasicReplicaFollower final {
+public:
+  explicit BasicReplicaFollower(int fd);
+
+  size_t pump();
+  [[nodiscard]] const BasicTrie<Alphabet>& words() const noexcept { return trie; }
+  [[nodiscard]] bool inSync() const noexcept { return synced; }
+
+private:
+  int fd;
+  std::string buffer;
+  BasicTrie<Alphabet> trie;
+  bool synced{true};
+};
+
+/**
+ * @brief Follows a stream; pipes are switched to non-blocking reads so that pump() never waits.
+ * @param fd Read end of a pipe, or a file the leader appends to.
+ */
+template <typename Alphabet>
+inline BasicReplicaFollower<Alphabet>::BasicReplicaFollower(const int fd) : fd(fd) {
+  ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+}
+
+/**
+ * @brief Reads whatever the stream holds now and applies every complete frame.
+ *
+ * A file is read up to its current end; the next call continues from there.
+ *
+ * @return Number of frames applied.
+ */
+template <typename Alphabet>
+inline size_t BasicReplicaFollower<Alphabet>::pump() {
+  char chunk[64 * 1024];
+  ssize_t result = 0;
+  while ((result = ::read(fd, chunk, sizeof(chunk))) > 0) {
+    buffer.append(chunk, static_cast<size_t>(result));
+  }
+
+  size_t applied = 0;
+  size_t offset = 0;
+  while (offset < buffer.size()) {
+    size_t used = 0;
+    std::optional<DeltaFrame> frame = DeltaFrame::decode(std::string_view(buffer).substr(offset), used);
+    if (used == 0) {
+      break;
+    }
+    offset += used;
+    if (!frame.has_value() || frame->base != trie.digest()) {
+      synced = false;
+      continue;
+    }
+    trie.apply(frame->delta);
+    synced = trie.digest() == frame->target;
+    applied += 1;
+  }
+  buffer.erase(0, offset);
+  return applied;
+}
+
+using ReplicaPublisher = BasicReplicaPublisher<CharAlphabet>;
+using ReplicaFollower = BasicReplicaFollower<CharAlphabet>;
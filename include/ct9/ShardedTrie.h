@@ -0,0 +1,146 @@
+#pragma once
+#include <array>
+#include <climits>
+#include <cstddef>
+#include <mutex>
+#include <queue>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Trie.h"
+
+/**
+ * @brief Trie for many concurrent writers: the keyspace is split by leading byte into independent shards.
+ *
+ * Every word lives in the shard of its first character, and each shard is a separate trie behind its
+ * own reader/writer lock, so writers to different shards never wait for each other. insert(), del()
+ * and contain() touch exactly one shard and are linearizable. Since shards are ordered by their
+ * leading byte, autocomplete() concatenates them in order; an empty prefix holds every shard's lock
+ * at once, so it sees one consistent state of the whole trie.
+ */
+template <typename Alphabet = CharAlphabet>
+class BasicShardedTrie final {
+  struct alignas(64) Shard final {
+    mutable std::shared_mutex lock;
+    BasicTrie<Alphabet> trie;
+  };
+
+public:
+  static constexpr size_t kShards = 256;
+
+  BasicShardedTrie() = default;
+  explicit BasicShardedTrie(const std::vector<std::string>& words);
+  BasicShardedTrie(const BasicShardedTrie&) = delete;
+  BasicShardedTrie& operator=(const BasicShardedTrie&) = delete;
+
+  void insert(const std::string& text);
+  void del(const std::string& word);
+  [[nodiscard]] bool contain(const std::string& word) const;
+  [[nodiscard]] std::queue<std::string> autocomplete(const std::string& prefix, size_t count = INT_MAX) const;
+
+private:
+  [[nodiscard]] static size_t shardOf(std::string_view word) noexcept {
+    return word.empty() ? 0 : static_cast<unsigned char>(word.front());
+  }
+
+  std::array<Shard, kShards> shards;
+};
+
+using ShardedTrie = BasicShardedTrie<CharAlphabet>;
+
+/**
+ * @brief Creates a sharded trie holding the given words.
+ * @param words Words to insert.
+ */
+template <typename Alphabet>
+inline BasicShardedTrie<Alphabet>::BasicShardedTrie(const std::vector<std::string>& words) {
+  for (const std::string& word : words) {
+    insert(word);
+  }
+}
+
+/**
+ * @brief Inserts text into the trie.
+ *
+ * Splits the text at characters outside of the alphabet exactly like BasicTrie::insert(), then
+ * inserts every word into its own shard.
+ *
+ * @param text A single word or several words separated by non-alphabet characters.
+ */
+template <typename Alphabet>
+inline void BasicShardedTrie<Alphabet>::insert(const std::string& text) {
+  size_t start = 0;
+  for (size_t i = 0; i <= text.size(); ++i) {
+    if (i < text.size() && Alphabet::contains(text[i])) {
+      continue;
+    }
+    const std::string word = text.substr(start, i - start);
+    Shard& shard = shards[shardOf(word)];
+    {
+      std::unique_lock lock(shard.lock);
+      shard.trie.insert(word);
+    }
+    start = i + 1;
+  }
+}
+
+/**
+ * @brief Removes a word from the trie.
+ * @param word The word to be removed.
+ */
+template <typename Alphabet>
+inline void BasicShardedTrie<Alphabet>::del(const std::string& word) {
+  Shard& shard = shards[shardOf(word)];
+  std::unique_lock lock(shard.lock);
+  shard.trie.del(word);
+}
+
+/**
+ * @brief Checks if a given word exists in the trie.
+ * @param word The word to search for.
+ * @return true if the word was inserted and not deleted since.
+ */
+template <typename Alphabet>
+inline bool BasicShardedTrie<Alphabet>::contain(const std::string& word) const {
+  const Shard& shard = shards[shardOf(word)];
+  std::shared_lock lock(shard.lock);
+  return shard.trie.contain(word);
+}
+
+/**
+ * @brief Provides autocomplete suggestions from all shards.
+ * @param prefix The prefix string to search for.
+ * @param count The maximum number of autocomplete suggestions to return.
+ * @return Words starting with `prefix`, in lexicographical order.
+ */
+template <typename Alphabet>
+inline std::queue<std::string> BasicShardedTrie<Alphabet>::autocomplete(const std::string& prefix,
+                                                                        const size_t count) const {
+  if (!prefix.empty()) {
+    const Shard& shard = shards[shardOf(prefix)];
+    std::shared_lock lock(shard.lock);
+    return shard.trie.autocomplete(prefix, count);
+  }
+
+  // Locks are always taken in shard order, so two such readers cannot deadlock with each other.
+  std::vector<std::shared_lock<std::shared_mutex>> locks;
+  locks.reserve(kShards);
+  for (const Shard& shard : shards) {
+    locks.emplace_back(shard.lock);
+  }
+
+  std::queue<std::string> results;
+  for (const Shard& shard : shards) {
+    if (results.size() >= count) {
+      break;
+    }
+    std::queue<std::string> words = shard.trie.autocomplete("", count - results.size());
+    while (!words.empty()) {
+      results.push(std::move(words.front()));
+      words.pop();
+    }
+  }
+  return results;
+}
@@ -0,0 +1,153 @@
+#pragma once
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <queue>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Trie.h"
+
+/**
+ * @brief Read-only trie over a flattened node array.
+ *
+ * Nodes are laid out breadth-first with node 0 as the root. The children of every node are
+ * stored contiguously and sorted by label, so a whole dictionary fits in a single constexpr
+ * array generated at build time (see tools/dictgen.cc) and needs neither heap allocation
+ * nor file I/O before the first query.
+ */
+class StaticTrie final {
+public:
+  struct Node final {
+    std::uint32_t first_child;
+    std::uint16_t child_count;
+    char label;
+    bool end_of_word;
+  };
+
+  constexpr explicit StaticTrie(std::span<const Node> nodes) noexcept : nodes(nodes) {}
+
+  [[nodiscard]] constexpr bool contain(std::string_view word) const noexcept;
+  [[nodiscard]] std::queue<std::string> autocomplete(const std::string& prefix, size_t count = INT_MAX) const;
+  [[nodiscard]] constexpr size_t size() const noexcept { return nodes.empty() ? 0 : nodes.size() - 1; }
+
+  template <typename Alphabet>
+  [[nodiscard]] static std::vector<Node> flatten(const BasicTrie<Alphabet>& trie);
+
+private:
+  [[nodiscard]] constexpr const Node* findNode(std::string_view prefix) const noexcept;
+  std::span<const Node> nodes;
+};
+
+/**
+ * @brief Walks from the root along the given prefix.
+ *
+ * Children are sorted by label, so every step is a binary search over a contiguous range.
+ *
+ * @param prefix Path to follow.
+ * @return The node reached by the prefix, or nullptr if the path does not exist.
+ */
+constexpr const StaticTrie::Node* StaticTrie::findNode(const std::string_view prefix) const noexcept {
+  if (nodes.empty()) {
+    return nullptr;
+  }
+  const Node* node = nodes.data();
+  for (const char character : prefix) {
+    const Node* first = nodes.data() + node->first_child;
+    const Node* last = first + node->child_count;
+    const Node* child =
+        std::lower_bound(first, last, character, [](const Node& lhs, const char rhs) { return lhs.label < rhs; });
+    if (child == last || child->label != character) {
+      return nullptr;
+    }
+    node = child;
+  }
+  return node;
+}
+
+/**
+ * @brief Checks if a given word exists in the dictionary.
+ * @param word The word to search for.
+ * @return true if the word exists, false otherwise.
+ */
+constexpr bool StaticTrie::contain(const std::string_view word) const noexcept {
+  const Node* node = findNode(word);
+  return node != nullptr && node->end_of_word;
+}
+
+/**
+ * @brief Provides autocomplete suggestions based on the given prefix.
+ *
+ * Same contract as Trie::autocomplete: up to `count` words starting with `prefix`,
+ * in lexicographical order. The traversal uses an explicit stack of (node, next child) pairs.
+ *
+ * @param prefix The prefix string to search for.
+ * @param count The maximum number of autocomplete suggestions to return.
+ * @return A queue of strings containing the autocomplete suggestions.
+ */
+inline std::queue<std::string> StaticTrie::autocomplete(const std::string& prefix, const size_t count) const {
+  std::queue<std::string> results;
+  const Node* start = findNode(prefix);
+  if (start == nullptr || count == 0) {
+    return results;
+  }
+
+  std::string current = prefix;
+  if (start->end_of_word) {
+    results.push(current);
+  }
+
+  std::vector<std::pair<const Node*, std::uint16_t>> stack;
+  stack.emplace_back(start, 0);
+  while (!stack.empty() && results.size() < count) {
+    auto& [node, next] = stack.back();
+    if (next == node->child_count) {
+      stack.pop_back();
+      if (!stack.empty()) {
+        current.pop_back();
+      }
+      continue;
+    }
+
+    const Node* child = &nodes[node->first_child + next];
+    ++next;
+    current.push_back(child->label);
+    if (child->end_of_word) {
+      results.push(current);
+    }
+    stack.emplace_back(child, 0);
+  }
+  return results;
+}
+
+/**
+ * @brief Flattens a trie into the breadth-first node array used by StaticTrie.
+ * @param trie Source trie.
+ * @return Node array whose first element is the root.
+ */
+template <typename Alphabet>
+inline std::vector<StaticTrie::Node> StaticTrie::flatten(const BasicTrie<Alphabet>& trie) {
+  using SourceNode = decltype(trie.getRoot());
+
+  std::vector<Node> flat;
+  std::queue<std::pair<SourceNode, std::size_t>> queue;
+
+  flat.push_back({0, 0, '\0', trie.getRoot()->end_of_word});
+  queue.emplace(trie.getRoot(), 0);
+
+  while (!queue.empty()) {
+    const auto [source, index] = queue.front();
+    queue.pop();
+
+    flat[index].first_child = static_cast<std::uint32_t>(flat.size());
+    flat[index].child_count = static_cast<std::uint16_t>(source->children.size());
+    for (const auto& [key, child] : source->children) {
+      queue.emplace(child, flat.size());
+      flat.push_back({0, 0, key, child->end_of_word});
+    }
+  }
+  return flat;
+}
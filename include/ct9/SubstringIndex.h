@@ -0,0 +1,256 @@
+#pragma once
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "Trie.h"
+
+/**
+ * @brief Infix search over the words of a trie: finds every word that contains a string anywhere.
+ *
+ * Built as a generalized suffix automaton of all words: one state per class of substrings that
+ * end at the same set of word positions, with suffix links between them. A query walks its
+ * characters from the start state, so the state of the query is found in O(|q|). Every position
+ * where a word prefix ends is recorded at the state of that prefix; the words containing the
+ * query are exactly those recorded in the suffix-link subtree of its state. The subtrees are laid
+ * out in Euler-tour order, so each one is a contiguous run of word ids, and listing k words reads
+ * little more than k entries (a word that contains the query several times appears once per
+ * occurrence and is skipped after the first).
+ *
+ * Memory is 12 bytes per state, 5 per transition and 5 per word character (the recorded
+ * positions and a copy of the words), about 20 bytes per character for English-like words;
+ * states() and bytes() report the actual figures.
+ */
+class SubstringIndex final {
+public:
+  template <typename Alphabet>
+  explicit SubstringIndex(const BasicTrie<Alphabet>& trie);
+
+  [[nodiscard]] std::queue<std::string> contains_substring(std::string_view query, size_t count = INT_MAX) const;
+  [[nodiscard]] size_t states() const noexcept { return first.size(); }
+  [[nodiscard]] size_t bytes() const noexcept;
+
+private:
+  static constexpr std::uint32_t kNone = UINT32_MAX;
+
+  [[nodiscard]] std::uint32_t next(std::uint32_t state, char character) const noexcept;
+
+  // Transitions of state s are labels/targets[edges[s] .. edges[s + 1]), sorted by label.
+  std::vector<std::uint32_t> edges;
+  std::vector<char> labels;
+  std::vector<std::uint32_t> targets;
+  // Word ids recorded in the suffix-link subtree of state s are owners[first[s] .. last[s]).
+  std::vector<std::uint32_t> first;
+  std::vector<std::uint32_t> last;
+  std::vector<std::uint32_t> owners;
+  // Word i is text[offsets[i] .. offsets[i + 1]).
+  std::string text;
+  std::vector<std::uint32_t> offsets;
+};
+
+/**
+ * @brief Builds the index from every word of a trie.
+ *
+ * Words are added one at a time, each starting again from the initial state; transitions are kept
+ * in singly linked lists while the automaton grows and are packed into sorted arrays at the end.
+ *
+ * @param trie Dictionary to index. The total length of all words must stay below 2^31.
+ */
+template <typename Alphabet>
+inline SubstringIndex::SubstringIndex(const BasicTrie<Alphabet>& trie) {
+  struct Edge final {
+    char label;
+    std::uint32_t target;
+    std::uint32_t next;
+  };
+  std::vector<std::uint32_t> length{0};
+  std::vector<std::uint32_t> link{kNone};
+  std::vector<std::uint32_t> head{kNone};
+  std::vector<Edge> pool;
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> ends;
+
+  const auto find = [&](const std::uint32_t state, const char label) -> std::uint32_t* {
+    for (std::uint32_t edge = head[state]; edge != kNone; edge = pool[edge].next) {
+      if (pool[edge].label == label) {
+        return &pool[edge].target;
+      }
+    }
+    return nullptr;
+  };
+  const auto add = [&](const std::uint32_t state, const char label, const std::uint32_t target) {
+    pool.push_back({label, target, head[state]});
+    head[state] = static_cast<std::uint32_t>(pool.size() - 1);
+  };
+  const auto make = [&](const std::uint32_t len, const std::uint32_t suffix) {
+    length.push_back(len);
+    link.push_back(suffix);
+    head.push_back(kNone);
+    return static_cast<std::uint32_t>(length.size() - 1);
+  };
+  // Splits the shorter substrings of `target` off into a copy with the length `len`.
+  const auto split = [&](std::uint32_t state, const char label, const std::uint32_t target, const std::uint32_t len) {
+    const std::uint32_t clone = make(len, link[target]);
+    for (std::uint32_t edge = head[target]; edge != kNone; edge = pool[edge].next) {
+      add(clone, pool[edge].label, pool[edge].target);
+    }
+    for (; state != kNone; state = link[state]) {
+      std::uint32_t* step = find(state, label);
+      if (step == nullptr || *step != target) {
+        break;
+      }
+      *step = clone;
+    }
+    link[target] = clone;
+    return clone;
+  };
+  const auto extend = [&](const std::uint32_t previous, const char label) {
+    if (const std::uint32_t* existing = find(previous, label); existing != nullptr) {
+      const std::uint32_t target = *existing;
+      return length[previous] + 1 == length[target] ? target : split(previous, label, target, length[previous] + 1);
+    }
+    const std::uint32_t current = make(length[previous] + 1, 0);
+    std::uint32_t state = previous;
+    for (; state != kNone && find(state, label) == nullptr; state = link[state]) {
+      add(state, label, current);
+    }
+    if (state != kNone) {
+      const std::uint32_t target = *find(state, label);
+      link[current] = length[state] + 1 == length[target] ? target : split(state, label, target, length[state] + 1);
+    }
+    return current;
+  };
+
+  offsets.push_back(0);
+  for (std::queue<std::string> words = trie.autocomplete("", INT_MAX); !words.empty(); words.pop()) {
+    const std::string& word = words.front();
+    const auto id = static_cast<std::uint32_t>(offsets.size() - 1);
+    std::uint32_t state = 0;
+    for (const char character : word) {
+      state = extend(state, character);
+      ends.emplace_back(state, id);
+    }
+    text += word;
+    offsets.push_back(static_cast<std::uint32_t>(text.size()));
+  }
+
+  const size_t count = length.size();
+  edges.assign(count + 1, 0);
+  std::vector<std::pair<char, std::uint32_t>> sorted;
+  for (size_t state = 0; state < count; ++state) {
+    sorted.clear();
+    for (std::uint32_t edge = head[state]; edge != kNone; edge = pool[edge].next) {
+      sorted.emplace_back(pool[edge].label, pool[edge].target);
+    }
+    std::sort(sorted.begin(), sorted.end());
+    for (const auto& [label, target] : sorted) {
+      labels.push_back(label);
+      targets.push_back(target);
+    }
+    edges[state + 1] = static_cast<std::uint32_t>(labels.size());
+  }
+  pool = {};
+  head = {};
+
+  // Euler tour of the suffix-link tree; `order[s]` is the position of state s in the tour.
+  std::vector<std::uint32_t> children(count + 1, 0);
+  for (size_t state = 1; state < count; ++state) {
+    ++children[link[state] + 1];
+  }
+  for (size_t state = 0; state < count; ++state) {
+    children[state + 1] += children[state];
+  }
+  std::vector<std::uint32_t> child(count > 0 ? count - 1 : 0);
+  std::vector<std::uint32_t> fill(children.begin(), children.end() - 1);
+  for (size_t state = 1; state < count; ++state) {
+    child[fill[link[state]]++] = static_cast<std::uint32_t>(state);
+  }
+  std::vector<std::uint32_t> order(count);
+  std::vector<std::uint32_t> after(count);
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> stack{{0, children[0]}};
+  std::uint32_t clock = 0;
+  order[0] = clock++;
+  while (!stack.empty()) {
+    auto& [state, next_child] = stack.back();
+    if (next_child == children[state + 1]) {
+      after[state] = clock;
+      stack.pop_back();
+      continue;
+    }
+    const std::uint32_t descendant = child[next_child++];
+    order[descendant] = clock++;
+    stack.emplace_back(descendant, children[descendant]);
+  }
+
+  // Word ids bucketed by the tour position of the state they were recorded at.
+  std::vector<std::uint32_t> start(count + 1, 0);
+  for (const auto& [state, id] : ends) {
+    ++start[order[state] + 1];
+  }
+  for (size_t position = 0; position < count; ++position) {
+    start[position + 1] += start[position];
+  }
+  owners.resize(ends.size());
+  std::vector<std::uint32_t> cursor(start.begin(), start.end() - 1);
+  for (const auto& [state, id] : ends) {
+    owners[cursor[order[state]]++] = id;
+  }
+  first.resize(count);
+  last.resize(count);
+  for (size_t state = 0; state < count; ++state) {
+    first[state] = start[order[state]];
+    last[state] = start[after[state]];
+  }
+}
+
+/**
+ * @brief Follows one transition.
+ * @return The next state, or kNone if no word continues the current substring with `character`.
+ */
+inline std::uint32_t SubstringIndex::next(const std::uint32_t state, const char character) const noexcept {
+  const auto begin = labels.begin() + edges[state];
+  const auto end = labels.begin() + edges[state + 1];
+  const auto found = std::lower_bound(begin, end, character);
+  return found == end || *found != character ? kNone : targets[static_cast<size_t>(found - labels.begin())];
+}
+
+/**
+ * @brief Words that contain a string.
+ * @param query The substring to look for; an empty one matches every word.
+ * @param count The maximum number of words to return.
+ * @return Matching words, each once, in no particular order.
+ */
+inline std::queue<std::string> SubstringIndex::contains_substring(const std::string_view query,
+                                                                  const size_t count) const {
+  std::queue<std::string> results;
+  std::uint32_t state = 0;
+  for (const char character : query) {
+    state = next(state, character);
+    if (state == kNone) {
+      return results;
+    }
+  }
+
+  std::unordered_set<std::uint32_t> seen;
+  for (std::uint32_t i = first[state]; i < last[state] && results.size() < count; ++i) {
+    const std::uint32_t id = owners[i];
+    if (seen.insert(id).second) {
+      results.emplace(std::string_view(text).substr(offsets[id], offsets[id + 1] - offsets[id]));
+    }
+  }
+  return results;
+}
+
+/**
+ * @brief Memory held by the index, including the copy of the words.
+ */
+inline size_t SubstringIndex::bytes() const noexcept {
+  return edges.capacity() * sizeof(std::uint32_t) + labels.capacity() + targets.capacity() * sizeof(std::uint32_t) +
+         first.capacity() * sizeof(std::uint32_t) + last.capacity() * sizeof(std::uint32_t) +
+         owners.capacity() * sizeof(std::uint32_t) + text.capacity() + offsets.capacity() * sizeof(std::uint32_t);
+}
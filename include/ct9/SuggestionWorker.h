@@ -0,0 +1,182 @@
+#pragma once
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <string>
+#include <thread>
+#include <utility>
+
+/**
+ * @brief Computes suggestions on a background thread so that an event loop never waits for the trie.
+ *
+ * request() only records the prefix and returns; if the worker is still busy, a newer request
+ * replaces the one waiting, so stale keystrokes are dropped and only the latest prefix is computed.
+ * post() queues work that must not be dropped, such as inserting a word; tasks run in order
+ * before the next suggestion, on the same thread, so the trie is only ever touched by the worker.
+ *
+ * A finished result is handed back through take(). The worker also writes a byte to a pipe, so an
+ * event loop can wait for results with poll() on fd() next to its other descriptors.
+ */
+class SuggestionWorker final {
+public:
+  using Compute = std::function<std::queue<std::string>(const std::string& prefix)>;
+
+  struct Result final {
+    std::uint64_t ticket;
+    std::string prefix;
+    std::queue<std::string> words;
+  };
+
+  explicit SuggestionWorker(Compute compute);
+  ~SuggestionWorker();
+  SuggestionWorker(const SuggestionWorker&) = delete;
+  SuggestionWorker& operator=(const SuggestionWorker&) = delete;
+
+  std::uint64_t request(std::string prefix);
+  void post(std::function<void()> task);
+  [[nodiscard]] std::optional<Result> take();
+  [[nodiscard]] int fd() const noexcept { return pipe_fds[0]; }
+  [[nodiscard]] std::uint64_t dropped() const;
+
+private:
+  void run();
+
+  Compute compute;
+  int pipe_fds[2]{-1, -1};
+
+  mutable std::mutex mutex;
+  std::condition_variable wake;
+  std::deque<std::function<void()>> tasks;
+  std::optional<std::pair<std::uint64_t, std::string>> pending;
+  std::optional<Result> ready;
+  std::uint64_t tickets{0};
+  std::uint64_t coalesced{0};
+  bool stopping{false};
+  std::thread worker;
+};
+
+/**
+ * @brief Starts the worker thread.
+ * @param compute Produces the suggestions for a prefix; called on the worker thread only.
+ */
+inline SuggestionWorker::SuggestionWorker(Compute compute) : compute(std::move(compute)) {
+  if (::pipe(pipe_fds) == 0) {
+    for (const int descriptor : pipe_fds) {
+      ::fcntl(descriptor, F_SETFL, ::fcntl(descriptor, F_GETFL) | O_NONBLOCK);
+      ::fcntl(descriptor, F_SETFD, FD_CLOEXEC);
+    }
+  }
+  worker = std::thread(&SuggestionWorker::run, this);
+}
+
+/**
+ * @brief Runs the tasks still queued, abandons a pending request and joins the worker.
+ */
+inline SuggestionWorker::~SuggestionWorker() {
+  {
+    std::lock_guard lock(mutex);
+    stopping = true;
+  }
+  wake.notify_one();
+  worker.join();
+  for (const int descriptor : pipe_fds) {
+    if (descriptor >= 0) {
+      ::close(descriptor);
+    }
+  }
+}
+
+/**
+ * @brief Asks for the suggestions of a prefix, replacing any request the worker has not started yet.
+ * @param prefix Current input.
+ * @return Ticket of the request; the matching Result carries the same ticket.
+ */
+inline std::uint64_t SuggestionWorker::request(std::string prefix) {
+  std::uint64_t ticket = 0;
+  {
+    std::lock_guard lock(mutex);
+    ticket = ++tickets;
+    coalesced += pending.has_value() ? 1 : 0;
+    pending.emplace(ticket, std::move(prefix));
+  }
+  wake.notify_one();
+  return ticket;
+}
+
+/**
+ * @brief Queues a task to run on the worker thread before the next suggestion is computed.
+ * @param task Work that needs the trie, e.g. an insertion.
+ */
+inline void SuggestionWorker::post(std::function<void()> task) {
+  {
+    std::lock_guard lock(mutex);
+    tasks.push_back(std::move(task));
+  }
+  wake.notify_one();
+}
+
+/**
+ * @brief Collects the latest finished result and empties the notification pipe.
+ * @return The result, or nothing if none was finished since the last call.
+ */
+inline std::optional<SuggestionWorker::Result> SuggestionWorker::take() {
+  char drain[64];
+  while (pipe_fds[0] >= 0 && ::read(pipe_fds[0], drain, sizeof(drain)) > 0) {
+  }
+  std::lock_guard lock(mutex);
+  return std::exchange(ready, std::nullopt);
+}
+
+/**
+ * @brief Number of requests replaced by a newer one before the worker got to them.
+ */
+inline std::uint64_t SuggestionWorker::dropped() const {
+  std::lock_guard lock(mutex);
+  return coalesced;
+}
+
+/**
+ * @brief Worker loop: queued tasks first, then the latest request.
+ *
+ * A result is only published if no newer request arrived while it was being computed; otherwise
+ * the newer prefix is computed right away and the stale result is dropped.
+ */
+inline void SuggestionWorker::run() {
+  std::unique_lock lock(mutex);
+  while (true) {
+    wake.wait(lock, [&] { return stopping || !tasks.empty() || pending.has_value(); });
+    if (!tasks.empty()) {
+      std::function<void()> task = std::move(tasks.front());
+      tasks.pop_front();
+      lock.unlock();
+      task();
+      lock.lock();
+      continue;
+    }
+    if (stopping) {
+      return;
+    }
+
+    auto [ticket, prefix] = std::move(*pending);
+    pending.reset();
+    lock.unlock();
+    std::queue<std::string> words = compute(prefix);
+    lock.lock();
+
+    if (pending.has_value()) {
+      ++coalesced;
+      continue;
+    }
+    ready = Result{ticket, std::move(prefix), std::move(words)};
+    if (pipe_fds[1] >= 0) {
+      static_cast<void>(::write(pipe_fds[1], "", 1));
+    }
+  }
+}
@@ -0,0 +1,142 @@
+#pragma once
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Trie.h"
+
+/**
+ * @brief Digit-keyed index for T9 lookups in O(length).
+ *
+ * Every word is stored under its keypad encoding ("good" -> "4663"). A bucket keeps its words
+ * ranked by weight (highest first) and then lexicographically, so a lookup is one hash probe
+ * followed by copying the first `count` entries.
+ */
+class T9Index final {
+public:
+  T9Index() = default;
+  template <typename Alphabet>
+  explicit T9Index(const BasicTrie<Alphabet>& trie);
+
+  void insert(const std::string& word, std::uint64_t weight = 0);
+  void del(const std::string& word);
+  [[nodiscard]] std::queue<std::string> t9_lookup(std::string_view digits, size_t count = INT_MAX) const;
+  [[nodiscard]] size_t size() const noexcept { return words; }
+
+  [[nodiscard]] static std::string encode(std::string_view word);
+
+private:
+  struct Entry final {
+    std::string word;
+    std::uint64_t weight;
+  };
+
+  [[nodiscard]] static bool ranksBefore(const Entry& lhs, const Entry& rhs) {
+    return lhs.weight != rhs.weight ? lhs.weight > rhs.weight : lhs.word < rhs.word;
+  }
+
+  std::unordered_map<std::string, std::vector<Entry>> buckets;
+  size_t words{0};
+};
+
+/**
+ * @brief Builds the index from every word of a trie, all with weight 0.
+ * @param trie Source dictionary.
+ */
+template <typename Alphabet>
+inline T9Index::T9Index(const BasicTrie<Alphabet>& trie) {
+  std::queue<std::string> all = trie.autocomplete("", INT_MAX);
+  while (!all.empty()) {
+    insert(all.front());
+    all.pop();
+  }
+}
+
+/**
+ * @brief Converts a word to the digits typed for it.
+ * @param word Word made of letters.
+ * @return Keypad digits, or an empty string if some character has no key.
+ */
+inline std::string T9Index::encode(const std::string_view word) {
+  std::string digits(word.size(), '\0');
+  for (size_t i = 0; i < word.size(); ++i) {
+    digits[i] = t9Digit(word[i]);
+    if (digits[i] == '\0') {
+      return {};
+    }
+  }
+  return digits;
+}
+
+/**
+ * @brief Adds a word or updates the weight of an existing one.
+ * @param word Word to index. Words with characters that have no key are ignored.
+ * @param weight Ranking weight, e.g. a usage frequency.
+ */
+inline void T9Index::insert(const std::string& word, const std::uint64_t weight) {
+  const std::string digits = encode(word);
+  if (digits.empty()) {
+    return;
+  }
+
+  std::vector<Entry>& bucket = buckets[digits];
+  const auto existing =
+      std::find_if(bucket.begin(), bucket.end(), [&](const Entry& entry) { return entry.word == word; });
+  if (existing != bucket.end()) {
+    bucket.erase(existing);
+  } else {
+    ++words;
+  }
+
+  Entry entry{word, weight};
+  bucket.insert(std::lower_bound(bucket.begin(), bucket.end(), entry, ranksBefore), std::move(entry));
+}
+
+/**
+ * @brief Removes a word from the index.
+ * @param word The word to be removed.
+ */
+inline void T9Index::del(const std::string& word) {
+  const auto bucket = buckets.find(encode(word));
+  if (bucket == buckets.end()) {
+    return;
+  }
+
+  auto& entries = bucket->second;
+  const auto existing =
+      std::find_if(entries.begin(), entries.end(), [&](const Entry& entry) { return entry.word == word; });
+  if (existing == entries.end()) {
+    return;
+  }
+  entries.erase(existing);
+  --words;
+  if (entries.empty()) {
+    buckets.erase(bucket);
+  }
+}
+
+/**
+ * @brief Finds words typed with a digit sequence.
+ * @param digits Keys pressed, '2'..'9'.
+ * @param count The maximum number of words to return.
+ * @return Words ranked by weight, then lexicographically.
+ */
+inline std::queue<std::string> T9Index::t9_lookup(const std::string_view digits, const size_t count) const {
+  std::queue<std::string> results;
+  const auto bucket = buckets.find(std::string(digits));
+  if (bucket == buckets.end()) {
+    return results;
+  }
+  for (const Entry& entry : bucket->second) {
+    if (results.size() >= count) {
+      break;
+    }
+    results.push(entry.word);
+  }
+  return results;
+}
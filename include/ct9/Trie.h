@@ -1,90 +1,800 @@
 #pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <chrono>
 #include <climits>
-#include <functional>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
 #include <map>
 #include <memory>
+#include <optional>
 #include <queue>
+#include <span>
 #include <string>
+#include <string_view>
 #include <unordered_set>
 #include <utility>
 #include <vector>
+#if defined(__linux__)
+#include <unistd.h>
+
+#include <fstream>
+#endif
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
 #ifdef UNIT_TEST
 #define PRIVATE public
 #else
 #define PRIVATE private
 #endif
 
-class Trie final {
+/**
+ * @brief Default alphabet: ASCII letters, children stored in an ordered std::map.
+ *
+ * Any character outside of the alphabet acts as a word separator on insertion.
+ */
+struct CharAlphabet final {
+  template <typename Node>
+  using Children = std::map<char, Node*>;
+
+  [[nodiscard]] static constexpr bool contains(const char character) noexcept {
+    return (character >= 'a' && character <= 'z') || (character >= 'A' && character <= 'Z');
+  }
+};
+
+template <typename Alphabet, typename Node>
+class DenseChildren;
+
+/**
+ * @brief Small contiguous alphabet [First, Last] with a fixed-width dense child array.
+ *
+ * The character-to-slot mapping is a constexpr subtraction, so child lookup is a direct index
+ * instead of a tree search.
+ */
+template <char First, char Last>
+struct RangeAlphabet final {
+  static_assert(First <= Last, "RangeAlphabet bounds are reversed");
+
+  static constexpr std::size_t kSize = static_cast<std::size_t>(Last - First) + 1;
+
+  template <typename Node>
+  using Children = DenseChildren<RangeAlphabet, Node>;
+
+  [[nodiscard]] static constexpr bool contains(const char character) noexcept {
+    return character >= First && character <= Last;
+  }
+  [[nodiscard]] static constexpr std::size_t index(const char character) noexcept {
+    return static_cast<std::size_t>(character - First);
+  }
+  [[nodiscard]] static constexpr char symbol(const std::size_t index) noexcept {
+    return static_cast<char>(First + static_cast<char>(index));
+  }
+};
+
+using LowercaseAlphabet = RangeAlphabet<'a', 'z'>;
+using DigitAlphabet = RangeAlphabet<'0', '9'>;
+
+/**
+ * @brief Map-like container over a fixed array of child pointers.
+ *
+ * Mirrors the subset of the std::map interface used by the trie so that the same node code works
+ * for both sparse and dense alphabets. Iteration visits present children in alphabet order and
+ * yields (character, child) pairs by value.
+ */
+template <typename Alphabet, typename Node>
+class DenseChildren final {
+public:
+  using value_type = std::pair<const char, Node*>;
+
+  class const_iterator final {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = DenseChildren::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = value_type;
+
+    struct arrow_proxy final {
+      value_type pair;
+      const value_type* operator->() const { return &pair; }
+    };
+
+    const_iterator() = default;
+    const_iterator(const DenseChildren* owner, const std::size_t index) : owner(owner), index(index) { skipEmpty(); }
+
+    reference operator*() const { return {Alphabet::symbol(index), owner->slots[index]}; }
+    arrow_proxy operator->() const { return {**this}; }
+    const_iterator& operator++() {
+      ++index;
+      skipEmpty();
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator copy = *this;
+      ++*this;
+      return copy;
+    }
+    bool operator==(const const_iterator& other) const { return index == other.index; }
+
+  private:
+    void skipEmpty() {
+      while (index < Alphabet::kSize && owner->slots[index] == nullptr) {
+        ++index;
+      }
+    }
+
+    const DenseChildren* owner{nullptr};
+    std::size_t index{Alphabet::kSize};
+  };
+  using iterator = const_iterator;
+
+  Node*& operator[](const char character) { return slots[Alphabet::index(character)]; }
+  [[nodiscard]] bool contains(const char character) const {
+    return Alphabet::contains(character) && slots[Alphabet::index(character)] != nullptr;
+  }
+  [[nodiscard]] const_iterator find(const char character) const {
+    return contains(character) ? const_iterator(this, Alphabet::index(character)) : end();
+  }
+  [[nodiscard]] const_iterator begin() const { return {this, 0}; }
+  [[nodiscard]] const_iterator end() const { return {this, Alphabet::kSize}; }
+
+  std::size_t erase(const char character) {
+    if (!contains(character)) {
+      return 0;
+    }
+    slots[Alphabet::index(character)] = nullptr;
+    return 1;
+  }
+  void clear() { slots.fill(nullptr); }
+
+  [[nodiscard]] bool empty() const { return begin() == end(); }
+  [[nodiscard]] std::size_t size() const {
+    return static_cast<std::size_t>(std::distance(begin(), end()));
+  }
+
+private:
+  std::array<Node*, Alphabet::kSize> slots{};
+};
+
+/**
+ * @brief Asks the CPU to start loading a node that is about to be visited.
+ * @param node Node to prefetch, every cache line of it; may be null.
+ */
+template <typename Node>
+inline void prefetchNode(const Node* node) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  for (size_t offset = 0; offset < sizeof(Node); offset += 64) {
+    __builtin_prefetch(reinterpret_cast<const char*>(node) + offset);
+  }
+#else
+  static_cast<void>(node);
+#endif
+}
+
+/**
+ * @brief Maps a letter to its key on a phone keypad (ITU E.161).
+ * @param character Letter of either case.
+ * @return Digit '2'..'9', or '\0' if the character is not a letter.
+ */
+[[nodiscard]] constexpr char t9Digit(const char character) noexcept {
+  constexpr std::string_view kKeys = "22233344455566677778889999";
+  if (character >= 'a' && character <= 'z') {
+    return kKeys[static_cast<std::size_t>(character - 'a')];
+  }
+  if (character >= 'A' && character <= 'Z') {
+    return kKeys[static_cast<std::size_t>(character - 'A')];
+  }
+  return '\0';
+}
+
+/**
+ * @brief Compiled wildcard pattern, matched as a lazily built DFA.
+ *
+ * Syntax: `?` or `_` match exactly one character, `*` matches any (possibly empty) sequence,
+ * `[abc]`, `[a-z]` and `[!a-z]` (or `[^a-z]`) match one character from a class. Everything else
+ * is a literal. An unterminated `[` is a literal too.
+ *
+ * A DFA state is the set of pattern positions that are still alive. State sets are interned and
+ * their transitions are memoized, so a `*` never causes the same suffix of the pattern to be
+ * tried twice for the same input prefix.
+ */
+class WildcardPattern final {
+public:
+  static constexpr std::size_t kDead = 0;
+
+  explicit WildcardPattern(std::string_view pattern);
+
+  [[nodiscard]] std::size_t start() const noexcept { return start_state; }
+  [[nodiscard]] std::size_t next(std::size_t state, char character);
+  [[nodiscard]] bool accepting(std::size_t state) const noexcept { return states[state].accepting; }
+  [[nodiscard]] bool direct(std::size_t state) const noexcept { return states[state].direct; }
+  [[nodiscard]] const std::string& literals(std::size_t state) const noexcept { return states[state].literals; }
+  [[nodiscard]] bool matches(std::string_view word);
+
+private:
+  static constexpr std::size_t kUnknown = SIZE_MAX;
+  static constexpr std::size_t kMaxLiterals = 4;
+
+  struct Token final {
+    std::bitset<UCHAR_MAX + 1> accepts;
+    bool star{false};
+  };
+
+  struct State final {
+    std::vector<std::size_t> positions;
+    std::array<std::size_t, UCHAR_MAX + 1> transitions;
+    std::string literals;
+    bool direct{false};
+    bool accepting{false};
+  };
+
+  [[nodiscard]] std::size_t intern(std::vector<std::size_t> positions);
+
+  std::vector<Token> tokens;
+  std::vector<State> states;
+  std::map<std::vector<std::size_t>, std::size_t> ids;
+  std::size_t start_state{kDead};
+};
+
+/**
+ * @brief Parses a pattern into tokens and builds the initial DFA state.
+ * @param pattern Wildcard pattern, see the class description for the syntax.
+ */
+inline WildcardPattern::WildcardPattern(const std::string_view pattern) {
+  for (std::size_t i = 0; i < pattern.size(); ++i) {
+    Token token;
+    const char character = pattern[i];
+    const std::size_t close = character == '[' ? pattern.find(']', i + 2) : std::string_view::npos;
+
+    if (character == '*') {
+      if (!tokens.empty() && tokens.back().star) {
+        continue;
+      }
+      token.star = true;
+    } else if (character == '?' || character == '_') {
+      token.accepts.set();
+    } else if (close != std::string_view::npos) {
+      std::size_t j = i + 1;
+      const bool negate = pattern[j] == '!' || pattern[j] == '^';
+      if (negate) {
+        ++j;
+      }
+      for (; j < close; ++j) {
+        const auto low = static_cast<unsigned char>(pattern[j]);
+        if (j + 2 < close && pattern[j + 1] == '-') {
+          const auto high = static_cast<unsigned char>(pattern[j + 2]);
+          for (unsigned value = low; value <= high; ++value) {
+            token.accepts.set(value);
+          }
+          j += 2;
+        } else {
+          token.accepts.set(low);
+        }
+      }
+      if (negate) {
+        token.accepts.flip();
+      }
+      i = close;
+    } else {
+      token.accepts.set(static_cast<unsigned char>(character));
+    }
+    tokens.push_back(token);
+  }
+
+  static_cast<void>(intern({}));
+  start_state = intern({0});
+}
+
+/**
+ * @brief Returns the id of a position set, creating the DFA state on first use.
+ *
+ * Positions are closed over `*` (a star may match the empty sequence) before interning.
+ *
+ * @param positions Alive pattern positions.
+ * @return Id of the interned state.
+ */
+inline std::size_t WildcardPattern::intern(std::vector<std::size_t> positions) {
+  std::vector<std::size_t> closed;
+  for (std::size_t position : positions) {
+    closed.push_back(position);
+    while (position < tokens.size() && tokens[position].star) {
+      closed.push_back(++position);
+    }
+  }
+  std::sort(closed.begin(), closed.end());
+  closed.erase(std::unique(closed.begin(), closed.end()), closed.end());
+
+  const auto [it, inserted] = ids.try_emplace(closed, states.size());
+  if (!inserted) {
+    return it->second;
+  }
+
+  State state;
+  state.transitions.fill(kUnknown);
+  std::bitset<UCHAR_MAX + 1> advancing;
+  bool star = false;
+  for (const std::size_t position : closed) {
+    if (position == tokens.size()) {
+      state.accepting = true;
+    } else if (tokens[position].star) {
+      star = true;
+    } else {
+      advancing |= tokens[position].accepts;
+    }
+  }
+  // A state that can only advance on a handful of characters is walked by direct child lookups.
+  state.direct = !star && advancing.count() <= kMaxLiterals;
+  if (state.direct) {
+    for (int value = CHAR_MIN; value <= CHAR_MAX; ++value) {
+      if (advancing.test(static_cast<unsigned char>(value))) {
+        state.literals.push_back(static_cast<char>(value));
+      }
+    }
+  }
+  state.positions = std::move(closed);
+  states.push_back(std::move(state));
+  return it->second;
+}
+
+/**
+ * @brief Follows one input character from a DFA state.
+ * @param state Current state id.
+ * @param character Input character.
+ * @return Next state id, kDead if no pattern position survives.
+ */
+inline std::size_t WildcardPattern::next(const std::size_t state, const char character) {
+  const auto value = static_cast<unsigned char>(character);
+  if (states[state].transitions[value] != kUnknown) {
+    return states[state].transitions[value];
+  }
+
+  std::vector<std::size_t> positions;
+  for (const std::size_t position : states[state].positions) {
+    if (position == tokens.size()) {
+      continue;
+    }
+    if (tokens[position].star) {
+      positions.push_back(position);
+    } else if (tokens[position].accepts.test(value)) {
+      positions.push_back(position + 1);
+    }
+  }
+  const std::size_t target = intern(std::move(positions));
+  states[state].transitions[value] = target;
+  return target;
+}
+
+/**
+ * @brief Matches a whole word against the pattern.
+ * @param word Word to test.
+ * @return true if the entire word matches.
+ */
+inline bool WildcardPattern::matches(const std::string_view word) {
+  std::size_t state = start_state;
+  for (const char character : word) {
+    state = next(state, character);
+    if (state == kDead) {
+      return false;
+    }
+  }
+  return accepting(state);
+}
+
+/**
+ * @brief Word-level difference between two tries, see BasicTrie::diff().
+ *
+ * Both lists are in lexicographical order.
+ */
+struct TrieDelta final {
+  std::vector<std::string> inserts;
+  std::vector<std::string> deletes;
+
+  [[nodiscard]] bool empty() const noexcept { return inserts.empty() && deletes.empty(); }
+};
+
+/**
+ * @brief Prefix tree parameterized by an alphabet policy.
+ *
+ * The policy decides which characters belong to words and how children are stored:
+ * CharAlphabet keeps the sparse std::map layout, RangeAlphabet uses a dense array.
+ *
+ * @tparam Alphabet Alphabet policy, see CharAlphabet and RangeAlphabet.
+ */
+template <typename Alphabet = CharAlphabet>
+class BasicTrie final {
   struct Node final {
     Node();
     ~Node();
     Node(const Node&);
     void clearNode();
-    [[nodiscard]] std::queue<std::string> autocompleteNode(const std::string& prefix, size_t count) const;
-    void insert(const std::string& text, size_t index, Node* root);
+    [[nodiscard]] std::queue<std::string> autocompleteNode(const std::string& prefix, size_t count,
+                                                           bool touch = false) const;
+    bool insert(const std::string& text, size_t index, Node* root);
     [[nodiscard]] std::queue<std::string> find(char character) const;
     [[nodiscard]] std::string find() const;
     [[nodiscard]] size_t size() const;
-    std::map<char, Node*> children;
+    /// Sets the CLOCK bit of the word ending here; readers only store when it is clear.
+    void touch() const noexcept {
+      std::atomic_ref<std::uint8_t> bit(referenced);
+      if (bit.load(std::memory_order_relaxed) == 0) {
+        bit.store(1, std::memory_order_relaxed);
+      }
+    }
+    typename Alphabet::template Children<Node> children;
     bool end_of_word{false};
+    mutable std::uint8_t referenced{0};  ///< CLOCK bit: set by reads of the word, cleared by sweep().
+    mutable std::uint8_t uses{0};        ///< Decayed usage of the word ending here as a level, see record_use().
+    mutable std::uint8_t best{0};        ///< Upper bound of `uses` at this node and below it.
+    std::uint32_t words{0};              ///< Words ending at this node or below it.
+    mutable std::uint64_t digest{0};     ///< Hash of the words below this node, 0 while stale; see diff().
+    std::unique_ptr<std::string> forms;  ///< Spellings of the word ending here, see insert_form(); null if none.
   };
 
   PRIVATE : static void copyNodes(Node* dstRoot, const Node* srcRoot);
+  [[nodiscard]] Node* findNode(std::string_view prefix) const;
+  [[nodiscard]] static size_t residentBytes();
+  [[nodiscard]] std::vector<bool> lookupMany(std::span<const std::string> keys, bool whole_words) const;
+  [[nodiscard]] static std::uint8_t relaxed(std::uint8_t& level) noexcept {
+    return std::atomic_ref<std::uint8_t>(level).load(std::memory_order_relaxed);
+  }
+  [[nodiscard]] int usageScale(std::chrono::steady_clock::time_point now) const;
+  void rebaseUsage(int levels);
+  static void refreshDigests(const Node* node);
+  [[nodiscard]] static std::uint64_t mixDigest(std::uint64_t value) noexcept {
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+  }
+  static constexpr size_t kLookupGroup = 16;
+  static constexpr size_t kDeadlineStride = 32;
+  static constexpr size_t kStackReserve = 32;
+  static constexpr int kUsageSteps = 8;
+  static constexpr int kUsageRebase = 128;
   Node* root{nullptr};
+  std::chrono::steady_clock::time_point usage_origin{std::chrono::steady_clock::now()};
+  std::chrono::steady_clock::duration usage_half_life{std::chrono::hours(24)};
+  std::uint32_t usage_noise{0x9E3779B9u};
+  std::vector<std::string> compaction;
+  std::deque<Node*> relocated;
+
+public:
+  using Delta = TrieDelta;
+
+  /**
+   * @brief Work limit of a bounded autocomplete: whichever of the two runs out first stops the walk.
+   */
+  struct Budget final {
+    size_t nodes{SIZE_MAX};
+    std::chrono::steady_clock::time_point deadline{std::chrono::steady_clock::time_point::max()};
+  };
+
+  PRIVATE : template <typename Visitor>
+  void walkWords(const std::string& prefix, const Budget& budget, std::string& cursor, Visitor&& visit) const;
 
 public:
+
   /// Functions for testing
   const Node* getRoot() const { return root; }
   Node* getRoot() { return root; }
   void setRoot(Node* root) { this->root = root; }
   ///
 
-  Trie();
-  ~Trie();
-  Trie(const std::string& str);
-  Trie(const std::vector<std::string>& vec_str);
-
-  Trie(const Trie& trie);
-  Trie& operator=(const Trie& trie);
-  Trie(Trie&& trie) noexcept;
-
-  Trie operator+(const Trie& trie) const;
-  Trie operator-(const Trie& trie) const;
-  [[nodiscard]] bool operator<(const Trie& trie);
-  [[nodiscard]] bool operator==(const Trie& trie);
-  [[nodiscard]] bool operator>(const Trie& trie);
-  [[nodiscard]] bool operator!=(const Trie& trie); 
-  [[nodiscard]] bool operator<=(const Trie& trie);
-  [[nodiscard]] bool operator>=(const Trie& trie);
+  BasicTrie();
+  ~BasicTrie();
+  BasicTrie(const std::string& str);
+  BasicTrie(const std::vector<std::string>& vec_str);
+
+  BasicTrie(const BasicTrie& trie);
+  BasicTrie& operator=(const BasicTrie& trie);
+  BasicTrie(BasicTrie&& trie) noexcept;
+
+  BasicTrie operator+(const BasicTrie& trie) const;
+  BasicTrie operator-(const BasicTrie& trie) const;
+  [[nodiscard]] bool operator<(const BasicTrie& trie) const;
+  [[nodiscard]] bool operator==(const BasicTrie& trie) const;
+  [[nodiscard]] bool operator>(const BasicTrie& trie) const;
+  [[nodiscard]] bool operator!=(const BasicTrie& trie) const;
+  [[nodiscard]] bool operator<=(const BasicTrie& trie) const;
+  [[nodiscard]] bool operator>=(const BasicTrie& trie) const;
   [[nodiscard]] size_t size() const;
 
-  Trie& operator=(Trie&& trie) noexcept;
+  BasicTrie& operator=(BasicTrie&& trie) noexcept;
   void del(const std::string& text) const;
+  size_t erase_prefix(std::string_view prefix);
+  size_t erase_many(std::span<const std::string> words);
   std::string DEBUG(const Node* node, int x, int y, int level, int parent_x, int parent_y, char letter) const;
   [[nodiscard]] inline std::queue<std::string> autocomplete(const std::string& prefix, size_t count = INT_MAX) const;
+  [[nodiscard]] std::queue<std::string> autocomplete(const std::string& prefix, size_t count, const Budget& budget,
+                                                     std::string& cursor) const;
+  std::vector<std::string> sweep(std::string& hand, size_t count, size_t limit = SIZE_MAX);
+  void record_use(std::string_view word, std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+  void set_half_life(std::chrono::steady_clock::duration half_life) noexcept { usage_half_life = half_life; }
+  [[nodiscard]] double usage(std::string_view word,
+                             std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now()) const;
+  [[nodiscard]] std::queue<std::string> frequent(std::string_view prefix, size_t count = INT_MAX) const;
+  void insert_form(std::string_view key, std::string_view form);
+  bool erase_form(std::string_view key, std::string_view form);
+  [[nodiscard]] std::queue<std::string> autocomplete_forms(const std::string& prefix, size_t count = INT_MAX) const;
+  [[nodiscard]] Delta diff(const BasicTrie& other) const;
+  void apply(const Delta& delta);
+  [[nodiscard]] std::uint64_t digest() const;
   void insert(const std::string& text);
+  size_t compact();
+  bool compactStep(size_t budget);
+  static void releaseFreeMemory();
   [[nodiscard]] bool contain(const std::string& word) const;
+  [[nodiscard]] size_t longest_prefix_match(std::string_view text) const;
+  [[nodiscard]] std::queue<std::string> range(std::string_view lo, std::string_view hi, size_t count = INT_MAX) const;
+  [[nodiscard]] size_t rank(std::string_view word) const;
+  [[nodiscard]] std::optional<std::string> select(size_t index) const;
+  [[nodiscard]] std::vector<bool> contain_many(std::span<const std::string> words) const;
+  [[nodiscard]] std::vector<bool> prefix_many(std::span<const std::string> prefixes) const;
+  [[nodiscard]] std::queue<std::string> match(std::string_view pattern, size_t count = INT_MAX) const;
+  [[nodiscard]] std::queue<std::string> t9_lookup(std::string_view digits, size_t count = INT_MAX) const;
+  [[nodiscard]] static constexpr bool isValidKey(std::string_view key) noexcept;
 };
 
+using Trie = BasicTrie<CharAlphabet>;
+using LowercaseTrie = BasicTrie<LowercaseAlphabet>;
+using DigitTrie = BasicTrie<DigitAlphabet>;
+
+/**
+ * @brief Checks at compile time (or run time) that every character of a key belongs to the alphabet.
+ *
+ * Intended for static_assert on dictionary literals, e.g.
+ * `static_assert(LowercaseTrie::isValidKey("hello"));`.
+ *
+ * @param key The key to validate.
+ * @return true if the key is non-empty and consists only of alphabet characters.
+ */
+template <typename Alphabet>
+constexpr bool BasicTrie<Alphabet>::isValidKey(const std::string_view key) noexcept {
+  if (key.empty()) {
+    return false;
+  }
+  for (const char character : key) {
+    if (!Alphabet::contains(character)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Walks from the root along the given prefix.
+ * @param prefix Path to follow.
+ * @return The node reached by the prefix, or nullptr if the path does not exist.
+ */
+template <typename Alphabet>
+inline typename BasicTrie<Alphabet>::Node* BasicTrie<Alphabet>::findNode(const std::string_view prefix) const {
+  Node* tmp_node = root;
+  for (const char character : prefix) {
+    const auto child = tmp_node->children.find(character);
+    if (child == tmp_node->children.end()) {
+      return nullptr;
+    }
+    tmp_node = child->second;
+  }
+  return tmp_node;
+}
+
 /**
  * @brief Checks if a given word exists in the Trie.
  *
- * This method attempts to autocomplete the given word with a maximum result count of 1.
- * If exactly one result is found, the word is considered to be present in the Trie.
+ * Follows the word from the root and checks that the last node terminates a word, so a
+ * mere prefix of a stored word is not reported as present.
  *
  * @param word The word to search for in the Trie.
  * @return true if the word exists in the Trie, false otherwise.
  */
-inline bool Trie::contain(const std::string& word) const {
-  return this->autocomplete(word,1).size() == 1;
+template <typename Alphabet>
+inline bool BasicTrie<Alphabet>::contain(const std::string& word) const {
+  const Node* node = findNode(word);
+  if (node == nullptr || !node->end_of_word) {
+    return false;
+  }
+  node->touch();
+  return true;
+}
+/**
+ * @brief Length of the longest word that is a prefix of a text, in one descent.
+ * @param text Text whose beginning is matched, e.g. the rest of an unspaced input.
+ * @return Length of the longest stored word `text` starts with, 0 if there is none.
+ */
+template <typename Alphabet>
+inline size_t BasicTrie<Alphabet>::longest_prefix_match(const std::string_view text) const {
+  size_t longest = 0;
+  const Node* node = root;
+  for (size_t i = 0; i < text.size(); ++i) {
+    const auto child = node->children.find(text[i]);
+    if (child == node->children.end()) {
+      break;
+    }
+    node = child->second;
+    if (node->end_of_word) {
+      longest = i + 1;
+    }
+  }
+  return longest;
+}
+
+/**
+ * @brief Counts the stored words that sort before a key.
+ *
+ * Follows the key from the root and adds up the word counts of the subtrees to the left of the
+ * path, plus the proper prefixes of the key that are words, in O(length × alphabet).
+ *
+ * @param word Any key; it does not have to be stored.
+ * @return Number of stored words lexicographically smaller than `word`.
+ */
+template <typename Alphabet>
+inline size_t BasicTrie<Alphabet>::rank(const std::string_view word) const {
+  size_t smaller = 0;
+  const Node* node = root;
+  for (const char character : word) {
+    smaller += node->end_of_word ? 1 : 0;
+    const Node* next = nullptr;
+    for (const auto& [key, child] : node->children) {
+      if (key >= character) {
+        next = key == character ? child : nullptr;
+        break;
+      }
+      smaller += child->words;
+    }
+    if (next == nullptr) {
+      break;
+    }
+    node = next;
+  }
+  return smaller;
+}
+
+/**
+ * @brief Finds the word at a position of the lexicographic order.
+ *
+ * Skips whole subtrees by their word counts, in O(length × alphabet).
+ *
+ * @param index Zero-based position; select(rank(w)) == w for every stored word w.
+ * @return The word, or nothing if the trie holds `index` words or fewer.
+ */
+template <typename Alphabet>
+inline std::optional<std::string> BasicTrie<Alphabet>::select(size_t index) const {
+  if (index >= root->words) {
+    return std::nullopt;
+  }
+  std::string word;
+  const Node* node = root;
+  while (true) {
+    if (node->end_of_word) {
+      if (index == 0) {
+        return word;
+      }
+      --index;
+    }
+    for (const auto& [key, child] : node->children) {
+      if (index < child->words) {
+        word.push_back(key);
+        node = child;
+        break;
+      }
+      index -= child->words;
+    }
+  }
+}
+
+/**
+ * @brief Lists the words in a lexicographic range.
+ *
+ * The number of words in the range comes from two rank() descents; the words themselves are
+ * produced by the resumable autocomplete walk started at `lo`, so nothing before the range is visited.
+ *
+ * @param lo Inclusive lower bound.
+ * @param hi Exclusive upper bound.
+ * @param count The maximum number of words to return.
+ * @return Words w with lo <= w < hi in lexicographical order.
+ */
+template <typename Alphabet>
+inline std::queue<std::string> BasicTrie<Alphabet>::range(const std::string_view lo, const std::string_view hi,
+                                                          const size_t count) const {
+  const size_t first = rank(lo);
+  const size_t last = rank(hi);
+  if (last <= first) {
+    return {};
+  }
+  std::string cursor(lo);
+  return autocomplete("", std::min(count, last - first), {}, cursor);
+}
+
+/**
+ * @brief Checks many words at once; same answers as calling contain() on each of them.
+ *
+ * Up to kLookupGroup lookups are in flight together: each round advances every one of them by a
+ * single node and prefetches that node, so their cache misses overlap instead of being paid one
+ * after another. Pays off for large batches against a trie much bigger than the cache.
+ *
+ * @param words Words to look up.
+ * @return For each word, whether it is stored in the trie.
+ */
+template <typename Alphabet>
+inline std::vector<bool> BasicTrie<Alphabet>::contain_many(const std::span<const std::string> words) const {
+  return lookupMany(words, true);
+}
+
+/**
+ * @brief Checks many prefixes at once, interleaved like contain_many().
+ * @param prefixes Prefixes to look up.
+ * @return For each prefix, whether some word of the trie starts with it.
+ */
+template <typename Alphabet>
+inline std::vector<bool> BasicTrie<Alphabet>::prefix_many(const std::span<const std::string> prefixes) const {
+  return lookupMany(prefixes, false);
+}
+
+/**
+ * @brief Group-prefetched walk shared by contain_many() and prefix_many().
+ * @param keys Keys to follow from the root.
+ * @param whole_words Whether the last node must end a word, or only has some word at or below it.
+ */
+template <typename Alphabet>
+inline std::vector<bool> BasicTrie<Alphabet>::lookupMany(const std::span<const std::string> keys,
+                                                         const bool whole_words) const {
+  struct Lookup final {
+    size_t key;
+    size_t depth;
+    const Node* node;
+  };
+
+  std::vector<bool> found(keys.size(), false);
+  std::array<Lookup, kLookupGroup> group{};
+  size_t active = 0;
+  size_t next = 0;
+  while (active < kLookupGroup && next < keys.size()) {
+    group[active++] = {next++, 0, root};
+  }
+
+  while (active > 0) {
+    for (size_t i = 0; i < active;) {
+      Lookup& lookup = group[i];
+      const std::string& key = keys[lookup.key];
+      if (lookup.depth < key.size()) {
+        const auto child = lookup.node->children.find(key[lookup.depth]);
+        if (child != lookup.node->children.end()) {
+          lookup.node = child->second;
+          ++lookup.depth;
+          prefetchNode(lookup.node);
+          ++i;
+          continue;
+        }
+      } else {
+        found[lookup.key] = whole_words ? lookup.node->end_of_word : lookup.node->words > 0;
+      }
+
+      // This lookup is finished: its slot takes the next key, or the last active lookup.
+      if (next < keys.size()) {
+        lookup = {next++, 0, root};
+        ++i;
+      } else {
+        lookup = group[--active];
+      }
+    }
+  }
+  return found;
 }
+
 /**
  * @brief Checks if two tries are equal by comparing their stored words.
  * @note Will be optimized using BFS later.
  * @param trie The trie to compare with.
  * @return True if both tries contain the same words, false otherwise.
  */
-[[nodiscard]] inline bool Trie::operator==(const Trie& trie) {
+template <typename Alphabet>
+[[nodiscard]] inline bool BasicTrie<Alphabet>::operator==(const BasicTrie& trie) const {
   return this->autocomplete("", INT_MAX) == trie.autocomplete("", INT_MAX);
 }
 
@@ -94,7 +804,8 @@ inline bool Trie::contain(const std::string& word) const {
  * @param trie The trie to compare with.
  * @return True if the tries contain different words, false otherwise.
  */
-[[nodiscard]] inline bool Trie::operator!=(const Trie& trie) {
+template <typename Alphabet>
+[[nodiscard]] inline bool BasicTrie<Alphabet>::operator!=(const BasicTrie& trie) const {
   return this->autocomplete("", INT_MAX) != trie.autocomplete("", INT_MAX);
 }
 
@@ -104,7 +815,8 @@ inline bool Trie::contain(const std::string& word) const {
  * @param trie The trie to compare with.
  * @return True if this trie is lexicographically smaller.
  */
-[[nodiscard]] inline bool Trie::operator<(const Trie& trie) {
+template <typename Alphabet>
+[[nodiscard]] inline bool BasicTrie<Alphabet>::operator<(const BasicTrie& trie) const {
   return this->autocomplete("", INT_MAX) < trie.autocomplete("", INT_MAX);
 }
 
@@ -114,7 +826,8 @@ inline bool Trie::contain(const std::string& word) const {
  * @param trie The trie to compare with.
  * @return True if this trie is lexicographically greater.
  */
-[[nodiscard]] inline bool Trie::operator>(const Trie& trie) {
+template <typename Alphabet>
+[[nodiscard]] inline bool BasicTrie<Alphabet>::operator>(const BasicTrie& trie) const {
   return this->autocomplete("", INT_MAX) > trie.autocomplete("", INT_MAX);
 }
 
@@ -124,7 +837,8 @@ inline bool Trie::contain(const std::string& word) const {
  * @param trie The trie to compare with.
  * @return True if this trie is smaller or equal.
  */
-[[nodiscard]] inline bool Trie::operator<=(const Trie& trie) {
+template <typename Alphabet>
+[[nodiscard]] inline bool BasicTrie<Alphabet>::operator<=(const BasicTrie& trie) const {
   return this->autocomplete("", INT_MAX) <= trie.autocomplete("", INT_MAX);
 }
 
@@ -134,7 +848,8 @@ inline bool Trie::contain(const std::string& word) const {
  * @param trie The trie to compare with.
  * @return True if this trie is greater or equal.
  */
-[[nodiscard]] inline bool Trie::operator>=(const Trie& trie) {
+template <typename Alphabet>
+[[nodiscard]] inline bool BasicTrie<Alphabet>::operator>=(const BasicTrie& trie) const {
   return this->autocomplete("", INT_MAX) >= trie.autocomplete("", INT_MAX);
 }
 
@@ -147,8 +862,9 @@ inline bool Trie::contain(const std::string& word) const {
  * @param trie The Trie to merge with.
  * @return Trie containing all unique words from both Tries.
  */
-inline Trie Trie::operator+(const Trie& trie) const {
-  Trie new_trie;
+template <typename Alphabet>
+inline BasicTrie<Alphabet> BasicTrie<Alphabet>::operator+(const BasicTrie& trie) const {
+  BasicTrie new_trie;
   std::unordered_set<std::string> unique_words;
 
   std::queue<std::string> trie_words = trie.getRoot()->autocompleteNode("", INT_MAX);
@@ -179,9 +895,10 @@ inline Trie Trie::operator+(const Trie& trie) const {
  * @param trie The Trie whose words should be removed from this Trie.
  * @return Trie containing only words unique to this Trie.
  */
-inline Trie Trie::operator-(const Trie& trie) const {
+template <typename Alphabet>
+inline BasicTrie<Alphabet> BasicTrie<Alphabet>::operator-(const BasicTrie& trie) const {
   std::queue<std::string> trie_words = trie.getRoot()->autocompleteNode("", INT_MAX);
-  Trie new_trie(*this);
+  BasicTrie new_trie(*this);
 
   while (!trie_words.empty()) {
     std::string word = trie_words.front();
@@ -196,16 +913,23 @@ inline Trie Trie::operator-(const Trie& trie) const {
  * @brief Trie copy constructor.
  * @param trie source of copy.
  */
-inline Trie::Trie(const Trie& trie) : root(new Node()) { copyNodes(root, trie.root); }
+template <typename Alphabet>
+inline BasicTrie<Alphabet>::BasicTrie(const BasicTrie& trie)
+    : root(new Node()), usage_origin(trie.usage_origin), usage_half_life(trie.usage_half_life) {
+  copyNodes(root, trie.root);
+}
 
 /**
  * @brief Assignment operator.
  * @param trie source.
  * @return New Trie.
  */
-inline Trie& Trie::operator=(const Trie& trie) {
+template <typename Alphabet>
+inline BasicTrie<Alphabet>& BasicTrie<Alphabet>::operator=(const BasicTrie& trie) {
   if (this != &trie) {
     copyNodes(root, trie.root);
+    usage_origin = trie.usage_origin;
+    usage_half_life = trie.usage_half_life;
   }
   return *this;
 }
@@ -214,7 +938,9 @@ inline Trie& Trie::operator=(const Trie& trie) {
  * Move constructor.
  * @param trie source of move.
  */
-inline Trie::Trie(Trie&& trie) noexcept {
+template <typename Alphabet>
+inline BasicTrie<Alphabet>::BasicTrie(BasicTrie&& trie) noexcept
+    : usage_origin(trie.usage_origin), usage_half_life(trie.usage_half_life) {
   root = trie.root;
   trie.root = new Node();
 }
@@ -222,16 +948,31 @@ inline Trie::Trie(Trie&& trie) noexcept {
 /**
  * @brief Basic Node constructor.
  */
-inline Trie::Node::Node() = default;
+template <typename Alphabet>
+inline BasicTrie<Alphabet>::Node::Node() = default;
 
 /**
  * @brief Node destructor.
- * Deletes all nodes.
- * @warning Add a pointer check.
+ * Deletes all nodes below this one. Nodes are detached from their children before they are
+ * deleted, so the work goes through an explicit stack and not through nested destructors.
  */
-inline Trie::Node::~Node() {
+template <typename Alphabet>
+inline BasicTrie<Alphabet>::Node::~Node() {
+  std::vector<Node*> pending;
   for (const auto& [key, value] : children) {
-    delete value;
+    pending.push_back(value);
+  }
+  while (!pending.empty()) {
+    Node* node = pending.back();
+    pending.pop_back();
+    if (node == nullptr) {
+      continue;
+    }
+    for (const auto& [key, value] : node->children) {
+      pending.push_back(value);
+    }
+    node->children.clear();
+    delete node;
   }
 }
 
@@ -239,22 +980,37 @@ inline Trie::Node::~Node() {
  * @brief Basic Trie constructor.
  * Creating new root node.
  */
-inline Trie::Trie() : root(new Node()) {}
+template <typename Alphabet>
+inline BasicTrie<Alphabet>::BasicTrie() : root(new Node()) {}
 
 /**
  * @brief Basic Trie destructor.
  * Deletes root node.
  */
-inline Trie::~Trie() { delete root; }
+template <typename Alphabet>
+inline BasicTrie<Alphabet>::~BasicTrie() {
+  delete root;
+  for (Node* node : relocated) {
+    node->children.clear();
+    delete node;
+  }
+}
 
 /**
- * @brief Counts all nodes under the current node, including itself.
- * @return The total number of nodes in the subtree rooted at this node.
+ * @brief Counts all nodes under the current node, not including itself.
+ * @return The number of nodes below this node.
  */
-inline size_t Trie::Node::size() const {
-  size_t current_node_childrens_size = children.size();
-  for (const auto& [key, value] : children) {
-    current_node_childrens_size += value->size();
+template <typename Alphabet>
+inline size_t BasicTrie<Alphabet>::Node::size() const {
+  size_t current_node_childrens_size = 0;
+  std::vector<const Node*> pending{this};
+  while (!pending.empty()) {
+    const Node* node = pending.back();
+    pending.pop_back();
+    current_node_childrens_size += node->children.size();
+    for (const auto& [key, value] : node->children) {
+      pending.push_back(value);
+    }
   }
   return current_node_childrens_size;
 }
@@ -263,7 +1019,8 @@ inline size_t Trie::Node::size() const {
  * @brief Returns the total number of nodes in the Trie.
  * @return The number of nodes in the entire tree.
  */
-inline size_t Trie::size() const {
+template <typename Alphabet>
+inline size_t BasicTrie<Alphabet>::size() const {
   return root->size();
 }
 
@@ -283,8 +1040,16 @@ inline size_t Trie::size() const {
  * @warning This function dynamically allocates memory for each new node in the destination trie.
  *          Ensure to properly manage memory to avoid leaks.
  */
-inline void Trie::copyNodes(Node* dstRoot, const Node* srcRoot) {
+template <typename Alphabet>
+inline void BasicTrie<Alphabet>::copyNodes(Node* dstRoot, const Node* srcRoot) {
   dstRoot->clearNode();
+  dstRoot->end_of_word = srcRoot->end_of_word;
+  dstRoot->words = srcRoot->words;
+  dstRoot->referenced = relaxed(srcRoot->referenced);
+  dstRoot->uses = relaxed(srcRoot->uses);
+  dstRoot->best = relaxed(srcRoot->best);
+  dstRoot->digest = 0;
+  dstRoot->forms = srcRoot->forms ? std::make_unique<std::string>(*srcRoot->forms) : nullptr;
   std::queue<const Node*> srcQueue;
   std::queue<Node*> dstQueue;
 
@@ -298,12 +1063,16 @@ inline void Trie::copyNodes(Node* dstRoot, const Node* srcRoot) {
     auto currentDstNode = dstQueue.front();
     dstQueue.pop();
 
-    for (auto& child : currentSrcNode->children) {
-      srcQueue.push(child.second);
+    for (const auto& [childChar, srcChild] : currentSrcNode->children) {
+      srcQueue.push(srcChild);
 
-      char childChar = child.first;
       Node* newDstNode = new Node;
-      newDstNode->end_of_word = child.second->end_of_word;
+      newDstNode->end_of_word = srcChild->end_of_word;
+      newDstNode->words = srcChild->words;
+      newDstNode->referenced = relaxed(srcChild->referenced);
+      newDstNode->uses = relaxed(srcChild->uses);
+      newDstNode->best = relaxed(srcChild->best);
+      newDstNode->forms = srcChild->forms ? std::make_unique<std::string>(*srcChild->forms) : nullptr;
 
       currentDstNode->children[childChar] = newDstNode;
       dstQueue.push(newDstNode);
@@ -320,24 +1089,31 @@ inline void Trie::copyNodes(Node* dstRoot, const Node* srcRoot) {
  *
  * @param word The word to be removed from the Trie.
  */
-inline void Trie::del(const std::string& word) const {
-  bool is_word = this->autocomplete(word, 1).size() == 1;
-  if (!is_word) {
+template <typename Alphabet>
+inline void BasicTrie<Alphabet>::del(const std::string& word) const {
+  if (!this->contain(word)) {
     return;
   }
   Node* tmp = root;
   std::vector<Node*> path;
+  path.reserve(word.size());
   for (char c : word) {
     path.push_back(tmp);
-    if (tmp->children.find(c) == tmp->children.end()) {
-      return;
-    }
     tmp = tmp->children[c];
   }
 
   tmp->end_of_word = false;
+  tmp->referenced = 0;
+  tmp->uses = 0;
+  tmp->digest = 0;
+  tmp->forms.reset();
+  --tmp->words;
+  for (Node* node : path) {
+    --node->words;
+    node->digest = 0;
+  }
 
-  for (int i = path.size() - 1; i >= 0; --i) {
+  for (int i = static_cast<int>(path.size()) - 1; i >= 0; --i) {
     Node* parent = path[i];
     char c = word[i];
 
@@ -351,43 +1127,174 @@ inline void Trie::del(const std::string& word) const {
 }
 
 /**
- * @brief Recursively clears all child nodes of this node.
- *
- * This method deletes all child nodes of the current node and clears the
- * children map. It effectively resets the subtree rooted at this node.
- *
- * @note This does not delete the current node itself, only its children.
- *       The node remains valid for further insertions or operations.
+ * @brief Deletes every word that starts with a prefix.
  *
- * @warning Ensure that no other references to the deleted child nodes exist,
- *          as this will lead to dangling pointers.
+ * The subtree under the prefix is detached from its parent in one step and then freed without
+ * recursion; ancestors that held nothing but this subtree are freed as well.
  *
- * @example
- * Node* root = new Node();
- * root->insert("apple", 0, root);
- * root->insert("banana", 0, root);
- * root->clear();  // The subtree is now empty, but root is still valid.
+ * @param prefix The prefix of the words to delete; an empty prefix empties the trie.
+ * @return Number of words deleted.
  */
-inline void Trie::Node::clearNode() {
-  for (auto& child : children) {
-    delete child.second;
+template <typename Alphabet>
+inline size_t BasicTrie<Alphabet>::erase_prefix(const std::string_view prefix) {
+  std::vector<Node*> path{root};
+  for (const char character : prefix) {
+    const auto child = path.back()->children.find(character);
+    if (child == path.back()->children.end()) {
+      return 0;
+    }
+    path.push_back(child->second);
+  }
+
+  size_t erased = 0;
+  std::vector<Node*> pending;
+  if (prefix.empty()) {
+    erased = root->words;
+    root->end_of_word = false;
+    root->referenced = 0;
+    root->uses = 0;
+    root->best = 0;
+    root->forms.reset();
+    for (const auto& [key, child] : root->children) {
+      pending.push_back(child);
+    }
+    root->children.clear();
+  } else {
+    erased = path.back()->words;
+    pending.push_back(path.back());
+    path.pop_back();
+    path.back()->children.erase(prefix.back());
+  }
+  for (Node* node : path) {
+    node->words -= static_cast<std::uint32_t>(erased);
+    node->digest = 0;
+  }
+
+  while (!pending.empty()) {
+    Node* node = pending.back();
+    pending.pop_back();
+    for (const auto& [key, child] : node->children) {
+      pending.push_back(child);
+    }
+    node->children.clear();
+    delete node;
+  }
+
+  for (size_t depth = path.size() - 1; depth > 0; --depth) {
+    Node* node = path[depth];
+    if (!node->children.empty() || node->end_of_word) {
+      break;
+    }
+    path[depth - 1]->children.erase(prefix[depth - 1]);
+    delete node;
+  }
+  return erased;
+}
+
+/**
+ * @brief Deletes a batch of words in one merged traversal.
+ *
+ * Consecutive words share the walk along their common prefix: the path of the previous word is
+ * only unwound down to where the next word diverges, freeing nodes that became empty on the way.
+ * Any order gives the same result; sorted input shares the most work.
+ *
+ * @param words The words to delete.
+ * @return Number of words that were stored and are now deleted.
+ */
+template <typename Alphabet>
+inline size_t BasicTrie<Alphabet>::erase_many(const std::span<const std::string> words) {
+  // path[d] is the node reached by the first d characters of `previous`.
+  std::vector<Node*> path{root};
+  std::string_view previous;
+  size_t erased = 0;
+
+  const auto unwind = [&](const size_t depth) {
+    while (path.size() > depth + 1) {
+      Node* node = path.back();
+      path.pop_back();
+      if (node->children.empty() && !node->end_of_word) {
+        path.back()->children.erase(previous[path.size() - 1]);
+        delete node;
+      }
+    }
+  };
+
+  for (const std::string& word : words) {
+    const size_t common =
+        static_cast<size_t>(std::mismatch(previous.begin(), previous.end(), word.begin(), word.end()).first -
+                            previous.begin());
+    unwind(std::min(common, path.size() - 1));
+    previous = word;
+
+    while (path.size() - 1 < word.size()) {
+      const auto child = path.back()->children.find(word[path.size() - 1]);
+      if (child == path.back()->children.end()) {
+        break;
+      }
+      path.push_back(child->second);
+    }
+    if (path.size() - 1 == word.size() && path.back()->end_of_word) {
+      path.back()->end_of_word = false;
+      path.back()->referenced = 0;
+      path.back()->uses = 0;
+      path.back()->forms.reset();
+      for (Node* node : path) {
+        --node->words;
+        node->digest = 0;
+      }
+      ++erased;
+    }
+  }
+  unwind(0);
+  return erased;
+}
+
+/**
+ * @brief Recursively clears all child nodes of this node.
+ *
+ * This method deletes all child nodes of the current node and clears the
+ * children map. It effectively resets the subtree rooted at this node.
+ *
+ * @note This does not delete the current node itself, only its children.
+ *       The node remains valid for further insertions or operations.
+ *
+ * @warning Ensure that no other references to the deleted child nodes exist,
+ *          as this will lead to dangling pointers.
+ *
+ * @example
+ * Node* root = new Node();
+ * root->insert("apple", 0, root);
+ * root->insert("banana", 0, root);
+ * root->clear();  // The subtree is now empty, but root is still valid.
+ */
+template <typename Alphabet>
+inline void BasicTrie<Alphabet>::Node::clearNode() {
+  for (const auto& [key, child] : children) {
+    delete child;
   }
   children.clear();
 }
 
-inline Trie::Trie(const std::string& str) : root(new Node()) { this->insert(str); }
+template <typename Alphabet>
+inline BasicTrie<Alphabet>::BasicTrie(const std::string& str) : root(new Node()) {
+  this->insert(str);
+}
 
-inline Trie::Trie(const std::vector<std::string>& vec_str) : root(new Node()) {
+template <typename Alphabet>
+inline BasicTrie<Alphabet>::BasicTrie(const std::vector<std::string>& vec_str) : root(new Node()) {
   for (const std::string& word : vec_str) {
     this->insert(word);
   }
 }
 
-inline Trie& Trie::operator=(Trie&& trie) noexcept {
+template <typename Alphabet>
+inline BasicTrie<Alphabet>& BasicTrie<Alphabet>::operator=(BasicTrie&& trie) noexcept {
   if (this != &trie) {
     delete root;
     root = trie.getRoot();
     trie.setRoot(nullptr);
+    usage_origin = trie.usage_origin;
+    usage_half_life = trie.usage_half_life;
   }
   return *this;
 }
@@ -403,62 +1310,655 @@ inline Trie& Trie::operator=(Trie&& trie) noexcept {
  * @return A queue of strings containing the autocomplete suggestions.
  *         The results are in lexicographical order.
  */
-[[nodiscard]] std::queue<std::string> Trie::autocomplete(const std::string& prefix, size_t count) const {
-  Node* tmp_node = root;
-  for (const auto& character : prefix) {
-    if (!tmp_node->children.contains(character)) {
-      return {};
+template <typename Alphabet>
+[[nodiscard]] std::queue<std::string> BasicTrie<Alphabet>::autocomplete(const std::string& prefix,
+                                                                        size_t count) const {
+  const Node* tmp_node = findNode(prefix);
+  if (tmp_node == nullptr) {
+    return {};
+  }
+  return tmp_node->autocompleteNode(prefix, count, true);
+}
+
+/**
+ * @brief Autocomplete with a cap on the work done per call, resumable where it stopped.
+ *
+ * Walks the same lexicographic DFS as autocomplete(), but gives up once `budget.nodes` nodes
+ * were visited or `budget.deadline` has passed (the clock is read every kDeadlineStride nodes).
+ * Every call visits at least one node, so a zero budget counts as one and paging always advances.
+ * The walk position is then stored in `cursor`: it is the key of the next node to visit, and
+ * passing it back continues with the words that follow. The cursor stays valid across insert()
+ * and del(); if its node was deleted meanwhile, the walk resumes at the next key after it.
+ *
+ * @param prefix The prefix string to search for in the trie.
+ * @param count The maximum number of autocomplete suggestions to return.
+ * @param budget Node and time limit of this call.
+ * @param cursor In: empty to start, or the cursor returned by the previous call for the same prefix.
+ *               Out: empty once every word with the prefix was returned, the resume point otherwise.
+ * @return The next words in lexicographical order; fewer than `count` if the budget ran out.
+ */
+template <typename Alphabet>
+inline std::queue<std::string> BasicTrie<Alphabet>::autocomplete(const std::string& prefix, const size_t count,
+                                                                 const Budget& budget, std::string& cursor) const {
+  std::queue<std::string> results;
+  if (count == 0) {
+    cursor.clear();
+    return results;
+  }
+  walkWords(prefix, budget, cursor, [&](const Node* node, const std::string& word) {
+    node->touch();
+    results.push(word);
+    return results.size() >= count;
+  });
+  return results;
+}
+
+/**
+ * @brief The resumable lexicographic walk behind the bounded autocomplete() and sweep().
+ *
+ * Calls `visit(node, word)` for every word under `prefix`, starting at `cursor`, until the
+ * visitor returns true or the budget runs out, and leaves the key of the next node in `cursor`
+ * (empty once the walk is complete). See autocomplete() for the cursor and budget rules.
+ */
+template <typename Alphabet>
+template <typename Visitor>
+inline void BasicTrie<Alphabet>::walkWords(const std::string& prefix, const Budget& budget, std::string& cursor,
+                                           Visitor&& visit) const {
+  using Iterator = decltype(std::as_const(root->children).begin());
+
+  const Node* node = findNode(prefix);
+  if (node == nullptr) {
+    cursor.clear();
+    return;
+  }
+
+  // Stack of (next child, end) for every node on the path from the prefix node to `node`.
+  std::vector<std::pair<Iterator, Iterator>> stack;
+  std::string current = prefix;
+  bool visit_node = true;
+  if (cursor.size() > prefix.size() && cursor.starts_with(prefix)) {
+    for (size_t depth = prefix.size(); depth < cursor.size(); ++depth) {
+      const char key = cursor[depth];
+      auto child = std::find_if(node->children.begin(), node->children.end(),
+                                [key](const auto& entry) { return entry.first >= key; });
+      if (child == node->children.end() || (*child).first != key) {
+        stack.emplace_back(child, node->children.end());
+        visit_node = false;
+        break;
+      }
+      stack.emplace_back(std::next(child), node->children.end());
+      current.push_back(key);
+      node = (*child).second;
+    }
+  }
+
+  size_t visited = 0;
+  bool full = false;
+  while (true) {
+    if (visit_node) {
+      const bool out_of_budget = visited >= std::max<size_t>(budget.nodes, 1) ||
+                                 (visited % kDeadlineStride == 0 && visited > 0 &&
+                                  std::chrono::steady_clock::now() >= budget.deadline);
+      if (full || out_of_budget) {
+        cursor = current;
+        return;
+      }
+      ++visited;
+      if (node->end_of_word) {
+        full = visit(node, current);
+      }
+      stack.emplace_back(node->children.begin(), node->children.end());
+      visit_node = false;
+    }
+
+    if (stack.empty()) {
+      break;
+    }
+    auto& [next, end] = stack.back();
+    if (next == end) {
+      stack.pop_back();
+      if (stack.empty()) {
+        break;
+      }
+      current.pop_back();
+      continue;
+    }
+    current.push_back((*next).first);
+    node = (*next).second;
+    ++next;
+    visit_node = true;
+  }
+
+  cursor.clear();
+}
+
+/**
+ * @brief One step of a CLOCK hand over the words: finds words that were not read since the last pass.
+ *
+ * Words are visited in lexicographical order from `hand`, wrapping around at the end. A word whose
+ * bit is set (contain() or autocomplete() returned it since the hand last passed) gets a second
+ * chance: its bit is cleared and it is skipped. Words with a clear bit are returned as victims;
+ * the caller decides whether to del() them. One call stops after a full revolution if it found any
+ * victim, and after two otherwise, so a trie where every word is hot still yields victims.
+ *
+ * @param hand In: where the previous sweep stopped (empty at first). Out: where this one stopped.
+ * @param count Number of victims wanted.
+ * @param limit Maximum number of words to look at in this call.
+ * @return Up to `count` cold words, each at most once.
+ */
+template <typename Alphabet>
+inline std::vector<std::string> BasicTrie<Alphabet>::sweep(std::string& hand, const size_t count,
+                                                           const size_t limit) {
+  std::vector<std::string> victims;
+  const size_t revolution = root->words;
+  size_t seen = 0;
+  bool done = revolution == 0 || count == 0 || limit == 0;
+  while (!done) {
+    walkWords("", {}, hand, [&](const Node* node, const std::string& word) {
+      ++seen;
+      std::atomic_ref<std::uint8_t> bit(node->referenced);
+      if (bit.load(std::memory_order_relaxed) != 0) {
+        bit.store(0, std::memory_order_relaxed);
+      } else {
+        victims.push_back(word);
+      }
+      done = victims.size() >= count || seen >= limit || seen >= 2 * revolution ||
+             (seen == revolution && !victims.empty());
+      return done;
+    });
+  }
+  return victims;
+}
+
+/**
+ * @brief Records that the user chose a word, so that frequent() ranks it higher.
+ *
+ * Usage decays exponentially: a use counts half as much after one half-life (set_half_life(),
+ * a day by default). Instead of aging every counter, the weight of a new use doubles every
+ * half-life, which ranks words exactly as decaying all of them would. The counter of a word is
+ * one byte on a log scale, kUsageSteps levels per doubling, rounded stochastically so that small
+ * increments still add up; when the weight of a use nears the top of the scale, all levels are
+ * shifted down by kUsageRebase once.
+ *
+ * Every node on the path keeps the highest level below it, raised here before the word's own
+ * level, so frequent() never has to rebuild anything. Levels are stored with relaxed atomics:
+ * this may run next to readers, though not next to other writers.
+ *
+ * @param word A stored word; anything else is ignored.
+ * @param now Time of the use.
+ */
+template <typename Alphabet>
+inline void BasicTrie<Alphabet>::record_use(const std::string_view word,
+                                            const std::chrono::steady_clock::time_point now) {
+  Node* node = findNode(word);
+  if (node == nullptr || !node->end_of_word) {
+    return;
+  }
+
+  int scale = usageScale(now);
+  if (scale >= kUsageRebase) {
+    const int shift = scale / kUsageRebase * kUsageRebase;
+    rebaseUsage(shift);
+    usage_origin += shift * (usage_half_life / kUsageSteps);
+    scale -= shift;
+  }
+
+  // Level L stands for a weight of 2^((L - 1) / kUsageSteps); this use weighs 2^(scale / kUsageSteps).
+  const int unit = scale + 1;
+  const int level = relaxed(node->uses);
+  double target = unit;
+  if (level > 0) {
+    const int high = std::max(level, unit);
+    const int low = std::min(level, unit);
+    target = high + kUsageSteps * std::log2(1.0 + std::exp2(static_cast<double>(low - high) / kUsageSteps));
+  }
+  usage_noise ^= usage_noise << 13;
+  usage_noise ^= usage_noise >> 17;
+  usage_noise ^= usage_noise << 5;
+  const double fraction = target - std::floor(target);
+  const int rounded = static_cast<int>(target) + (usage_noise < fraction * 4294967296.0 ? 1 : 0);
+  const auto next = static_cast<std::uint8_t>(std::min(rounded, static_cast<int>(UINT8_MAX)));
+
+  Node* step = root;
+  for (size_t depth = 0; depth <= word.size(); ++depth) {
+    if (relaxed(step->best) < next) {
+      std::atomic_ref<std::uint8_t>(step->best).store(next, std::memory_order_relaxed);
+    }
+    if (depth < word.size()) {
+      step = step->children.find(word[depth])->second;
+    }
+  }
+  std::atomic_ref<std::uint8_t>(node->uses).store(next, std::memory_order_relaxed);
+  node->touch();
+}
+
+/**
+ * @brief Decayed usage of a word, in uses at `now`: 1 for a single use right now, 0.5 a half-life later.
+ * @param word The word to look up.
+ * @param now Time the weight is measured at.
+ * @return Estimated usage; 0 if the word was never used or is not stored.
+ */
+template <typename Alphabet>
+inline double BasicTrie<Alphabet>::usage(const std::string_view word,
+                                         const std::chrono::steady_clock::time_point now) const {
+  const Node* node = findNode(word);
+  if (node == nullptr || !node->end_of_word) {
+    return 0;
+  }
+  const int level = relaxed(node->uses);
+  return level == 0 ? 0 : std::exp2(static_cast<double>(level - 1 - usageScale(now)) / kUsageSteps);
+}
+
+/**
+ * @brief Words with a prefix that were recorded with record_use(), most used first.
+ *
+ * Best-first search on the per-node maximum: a subtree is opened only when its best level is
+ * the highest one left, so the cost depends on `count` and the depth, not on the number of words
+ * below the prefix. Ties go to the lexicographically smaller word.
+ *
+ * @param prefix The prefix string to search for.
+ * @param count The maximum number of words to return.
+ * @return Used words starting with `prefix`, by decreasing usage.
+ */
+template <typename Alphabet>
+inline std::queue<std::string> BasicTrie<Alphabet>::frequent(const std::string_view prefix, const size_t count) const {
+  struct Entry final {
+    std::uint8_t level;
+    bool word;
+    std::string key;
+    const Node* node;
+  };
+  // Higher levels first, then smaller keys; a word comes before the subtree below it.
+  const auto after = [](const Entry& lhs, const Entry& rhs) {
+    if (lhs.level != rhs.level) {
+      return lhs.level < rhs.level;
+    }
+    if (lhs.key != rhs.key) {
+      return lhs.key > rhs.key;
+    }
+    return !lhs.word && rhs.word;
+  };
+
+  std::queue<std::string> results;
+  const Node* start = findNode(prefix);
+  if (start == nullptr || count == 0 || relaxed(start->best) == 0) {
+    return results;
+  }
+  std::priority_queue<Entry, std::vector<Entry>, decltype(after)> frontier(after);
+  frontier.push({relaxed(start->best), false, std::string(prefix), start});
+  while (!frontier.empty() && results.size() < count) {
+    Entry entry = frontier.top();
+    frontier.pop();
+    if (entry.word) {
+      entry.node->touch();
+      results.push(std::move(entry.key));
+      continue;
+    }
+    if (const std::uint8_t level = relaxed(entry.node->uses); entry.node->end_of_word && level > 0) {
+      frontier.push({level, true, entry.key, entry.node});
     }
-    tmp_node = tmp_node->children[character];
+    for (const auto& [key, child] : entry.node->children) {
+      if (const std::uint8_t level = relaxed(child->best); level > 0) {
+        frontier.push({level, false, entry.key + key, child});
+      }
+    }
+  }
+  return results;
+}
+
+/**
+ * @brief Number of kUsageSteps since the usage origin: the level of a use made at `now`, minus one.
+ */
+template <typename Alphabet>
+inline int BasicTrie<Alphabet>::usageScale(const std::chrono::steady_clock::time_point now) const {
+  const auto step = usage_half_life / kUsageSteps;
+  if (now <= usage_origin || step.count() <= 0) {
+    return 0;
+  }
+  return static_cast<int>(std::min<std::int64_t>((now - usage_origin) / step, INT_MAX));
+}
+
+/**
+ * @brief Lowers every usage level by the same amount, which keeps the ranking; words that drop to 0 are forgotten.
+ */
+template <typename Alphabet>
+inline void BasicTrie<Alphabet>::rebaseUsage(const int levels) {
+  const auto lower = [levels](std::uint8_t& level) {
+    const int value = relaxed(level);
+    std::atomic_ref<std::uint8_t>(level).store(static_cast<std::uint8_t>(std::max(0, value - levels)),
+                                               std::memory_order_relaxed);
+  };
+  std::vector<Node*> pending{root};
+  while (!pending.empty()) {
+    Node* node = pending.back();
+    pending.pop_back();
+    if (relaxed(node->best) == 0) {
+      continue;
+    }
+    lower(node->uses);
+    lower(node->best);
+    for (const auto& [key, child] : node->children) {
+      pending.push_back(child);
+    }
+  }
+}
+
+/**
+ * @brief Stores a word under a key that differs from its spelling, e.g. "Café" under "cafe".
+ *
+ * The key is inserted like any word and the spelling is kept on its end-of-word node, so all
+ * spellings of a key share one path. A node without stored spellings stands for the key itself:
+ * plain insert() costs nothing extra, and a spelling equal to a new key is not stored either.
+ * The spellings of a key are one string separated by '\0'; forms must not contain '\0'.
+ *
+ * Spellings are not part of digest(), diff() or comparisons, which only see keys.
+ *
+ * @param key The word to file the spelling under; must be a single word of the alphabet.
+ * @param form The spelling to return from autocomplete_forms(). Stored once however often it is added.
+ */
+template <typename Alphabet>
+inline void BasicTrie<Alphabet>::insert_form(const std::string_view key, const std::string_view form) {
+  if (!isValidKey(key)) {
+    return;
+  }
+  Node* node = findNode(key);
+  if (node == nullptr || !node->end_of_word) {
+    insert(std::string(key));
+    node = findNode(key);
+    if (form != key) {
+      node->forms = std::make_unique<std::string>(form);
+    }
+    return;
+  }
+  if (!node->forms) {
+    if (form == key) {
+      return;
+    }
+    node->forms = std::make_unique<std::string>(key);
+  }
+  for (size_t start = 0; start <= node->forms->size();) {
+    const size_t end = std::min(node->forms->find('\0', start), node->forms->size());
+    if (std::string_view(*node->forms).substr(start, end - start) == form) {
+      return;
+    }
+    start = end + 1;
+  }
+  node->forms->push_back('\0');
+  node->forms->append(form);
+}
+
+/**
+ * @brief Removes one spelling of a key; the key itself is deleted with its last spelling.
+ * @param key The key the spelling was stored under.
+ * @param form The spelling to remove.
+ * @return true if the spelling was stored.
+ */
+template <typename Alphabet>
+inline bool BasicTrie<Alphabet>::erase_form(const std::string_view key, const std::string_view form) {
+  Node* node = findNode(key);
+  if (node == nullptr || !node->end_of_word) {
+    return false;
+  }
+  if (!node->forms) {
+    if (form != key) {
+      return false;
+    }
+    del(std::string(key));
+    return true;
+  }
+  std::string& forms = *node->forms;
+  for (size_t start = 0; start <= forms.size();) {
+    const size_t end = std::min(forms.find('\0', start), forms.size());
+    if (std::string_view(forms).substr(start, end - start) != form) {
+      start = end + 1;
+      continue;
+    }
+    // Drop the form together with one of the separators around it.
+    if (end < forms.size()) {
+      forms.erase(start, end - start + 1);
+    } else {
+      forms.erase(start > 0 ? start - 1 : 0);
+    }
+    if (forms == key) {
+      node->forms.reset();
+    } else if (forms.empty()) {
+      del(std::string(key));
+    }
+    return true;
+  }
+  return false;
+}
+
+/**
+ * @brief Autocomplete that returns the stored spellings instead of the keys, see insert_form().
+ *
+ * One walk over the keys under the prefix, in lexicographical order of the keys; the spellings of
+ * one key come in the order they were first added, and a key without spellings is returned as is.
+ *
+ * @param prefix The key prefix to search for.
+ * @param count The maximum number of spellings to return.
+ * @return Spellings of the keys that start with `prefix`.
+ */
+template <typename Alphabet>
+inline std::queue<std::string> BasicTrie<Alphabet>::autocomplete_forms(const std::string& prefix,
+                                                                       const size_t count) const {
+  std::queue<std::string> results;
+  if (count == 0) {
+    return results;
+  }
+  std::string cursor;
+  walkWords(prefix, {}, cursor, [&](const Node* node, const std::string& word) {
+    node->touch();
+    if (!node->forms) {
+      results.push(word);
+      return results.size() >= count;
+    }
+    const std::string_view forms = *node->forms;
+    for (size_t start = 0; start <= forms.size() && results.size() < count;) {
+      const size_t end = std::min(forms.find('\0', start), forms.size());
+      results.emplace(forms.substr(start, end - start));
+      start = end + 1;
+    }
+    return results.size() >= count;
+  });
+  return results;
+}
+
+/**
+ * @brief Hash of all words in the trie; two tries with the same words have the same digest.
+ *
+ * Every node caches the hash of its subtree, combined from its end-of-word flag and its children's
+ * hashes. insert() and del() only mark the nodes on their path as stale, so after a small change
+ * this rehashes a few paths rather than the whole trie. Filling the cache writes to the nodes, so
+ * it must not run next to other readers.
+ *
+ * @return Digest of the trie.
+ */
+template <typename Alphabet>
+inline std::uint64_t BasicTrie<Alphabet>::digest() const {
+  refreshDigests(root);
+  return root->digest;
+}
+
+/**
+ * @brief Recomputes the stale digests below a node, children before their parents.
+ *
+ * Subtrees whose digest is still valid are not entered. A child's hash is mixed with its key
+ * and the children are summed, so the order of the children does not matter.
+ */
+template <typename Alphabet>
+inline void BasicTrie<Alphabet>::refreshDigests(const Node* node) {
+  std::vector<const Node*> stale;
+  std::vector<const Node*> pending{node};
+  while (!pending.empty()) {
+    const Node* current = pending.back();
+    pending.pop_back();
+    if (current->digest != 0) {
+      continue;
+    }
+    stale.push_back(current);
+    for (const auto& [key, child] : current->children) {
+      pending.push_back(child);
+    }
+  }
+
+  for (auto it = stale.rbegin(); it != stale.rend(); ++it) {
+    const Node* current = *it;
+    std::uint64_t sum = current->end_of_word ? 0x2545F4914F6CDD1Dull : 0x9E3779B97F4A7C15ull;
+    for (const auto& [key, child] : current->children) {
+      sum += mixDigest(child->digest ^ (static_cast<std::uint64_t>(static_cast<unsigned char>(key)) << 56));
+    }
+    current->digest = std::max<std::uint64_t>(1, mixDigest(sum));
+  }
+}
+
+/**
+ * @brief The changes that turn this trie into another one.
+ *
+ * Walks both tries in lockstep from the root and skips every pair of subtrees with equal digests
+ * (see digest()), so the work is proportional to the changed paths, not to the size of the tries.
+ * Where only one side has a subtree, all of its words go to the delta.
+ *
+ * @param other The trie to compare with.
+ * @return Words only in `other` as inserts and words only in this trie as deletes; `apply()` on a
+ *         copy of this trie then gives the words of `other`.
+ */
+template <typename Alphabet>
+inline typename BasicTrie<Alphabet>::Delta BasicTrie<Alphabet>::diff(const BasicTrie& other) const {
+  struct Step final {
+    const Node* mine;
+    const Node* theirs;
+    std::string key;
+  };
+  const auto collect = [](const Node* node, const std::string& key, std::vector<std::string>& out) {
+    for (std::queue<std::string> words = node->autocompleteNode(key, SIZE_MAX); !words.empty(); words.pop()) {
+      out.push_back(std::move(words.front()));
+    }
+  };
+
+  refreshDigests(root);
+  refreshDigests(other.root);
+  Delta delta;
+  std::vector<Step> pending{{root, other.root, std::string()}};
+  std::vector<Step> children;
+  while (!pending.empty()) {
+    const Step step = std::move(pending.back());
+    pending.pop_back();
+    if (step.theirs == nullptr) {
+      collect(step.mine, step.key, delta.deletes);
+      continue;
+    }
+    if (step.mine == nullptr) {
+      collect(step.theirs, step.key, delta.inserts);
+      continue;
+    }
+    if (step.mine->digest == step.theirs->digest) {
+      continue;
+    }
+    if (step.mine->end_of_word != step.theirs->end_of_word) {
+      (step.mine->end_of_word ? delta.deletes : delta.inserts).push_back(step.key);
+    }
+
+    // Children of both sides merged in key order, then stacked in reverse to be visited in order.
+    children.clear();
+    auto mine = step.mine->children.begin();
+    auto theirs = step.theirs->children.begin();
+    while (mine != step.mine->children.end() || theirs != step.theirs->children.end()) {
+      const bool take_mine = theirs == step.theirs->children.end() ||
+                             (mine != step.mine->children.end() && (*mine).first <= (*theirs).first);
+      const bool take_theirs = mine == step.mine->children.end() ||
+                               (theirs != step.theirs->children.end() && (*theirs).first <= (*mine).first);
+      const char key = take_mine ? (*mine).first : (*theirs).first;
+      children.push_back(
+          {take_mine ? (*mine).second : nullptr, take_theirs ? (*theirs).second : nullptr, step.key + key});
+      if (take_mine) {
+        ++mine;
+      }
+      if (take_theirs) {
+        ++theirs;
+      }
+    }
+    pending.insert(pending.end(), std::make_move_iterator(children.rbegin()),
+                   std::make_move_iterator(children.rend()));
+  }
+  return delta;
+}
+
+/**
+ * @brief Patches the trie with a delta from diff(): deletes first, in one erase_many() pass, then inserts.
+ * @param delta The changes to apply.
+ */
+template <typename Alphabet>
+inline void BasicTrie<Alphabet>::apply(const Delta& delta) {
+  static_cast<void>(erase_many(delta.deletes));
+  for (const std::string& word : delta.inserts) {
+    insert(word);
   }
-  return tmp_node->autocompleteNode(prefix, count);
 }
 
 /**
  * @brief Retrieves autocomplete suggestions starting with a specified prefix.
  *
  * This function performs a depth-first search (DFS) from the current trie node to collect words
- * that begin with the given prefix. A recursive lambda function is used for traversal. The
- * `current` string serves as a mutable buffer that holds the current path in the trie. When a
- * node marking the end of a valid word is encountered, the accumulated string in `current` is
- * added to the `results` queue. The DFS terminates early once the number of collected suggestions
- * reaches the specified limit.
+ * that begin with the given prefix. The `current` string serves as a mutable buffer that holds
+ * the current path in the trie. When a node marking the end of a valid word is encountered, the
+ * accumulated string in `current` is added to the `results` queue. The DFS terminates early once
+ * the number of collected suggestions reaches the specified limit.
  *
  * @param prefix The prefix string used as the starting point for generating autocomplete suggestions.
  * @param count The maximum number of autocomplete suggestions to retrieve.
+ * @param touch Whether the collected words count as read for sweep(); internal copies and comparisons pass false.
  * @return std::queue<std::string> A queue containing the autocomplete suggestions in DFS traversal order.
  *
- * @note The implementation uses backtracking to avoid unnecessary string copying. The recursive DFS
- *       function returns a boolean value to indicate whether the search should be terminated early.
+ * @note The implementation uses backtracking to avoid unnecessary string copying. The DFS keeps an
+ *       explicit stack of child iterators, so the depth of the trie is not limited by the call stack.
  */
-[[nodiscard]] inline std::queue<std::string> Trie::Node::autocompleteNode(const std::string& prefix,
-                                                                          const size_t count) const {
+template <typename Alphabet>
+[[nodiscard]] inline std::queue<std::string> BasicTrie<Alphabet>::Node::autocompleteNode(const std::string& prefix,
+                                                                                         const size_t count,
+                                                                                         const bool touch) const {
+  using Iterator = decltype(std::as_const(children).begin());
+
   std::queue<std::string> results;
+  if (count == 0) {
+    return results;
+  }
   std::string current = prefix;
-
-  std::function<bool(const Node*)> dfs = [&](const Node* node) -> bool {
-    if (results.size() >= count) {
-      return true;
+  if (end_of_word) {
+    if (touch) {
+      this->touch();
     }
+    results.push(current);
+  }
 
-    if (node->end_of_word) {
-      results.push(current);
-      if (results.size() >= count) {
-        return true;
+  // Stack of (next child, end) for every node on the path from this node to the current one.
+  std::vector<std::pair<Iterator, Iterator>> stack;
+  stack.reserve(kStackReserve);
+  stack.emplace_back(children.begin(), children.end());
+  while (!stack.empty() && results.size() < count) {
+    auto& [next, end] = stack.back();
+    if (next == end) {
+      stack.pop_back();
+      if (!stack.empty()) {
+        current.pop_back();
       }
+      continue;
     }
 
-    for (const auto& [key, child] : node->children) {
-      current.push_back(key);
-      if (dfs(child)) {
-        return true;
+    const auto& [key, child] = *next;
+    // The next sibling is loaded while the subtree of this child is being walked.
+    if (++next != end) {
+      prefetchNode((*next).second);
+    }
+    current.push_back(key);
+    if (child->end_of_word) {
+      if (touch) {
+        child->touch();
       }
-      current.pop_back();
+      results.push(current);
     }
-    return false;
-  };
-
-  static_cast<void>(dfs(this));
+    stack.emplace_back(child->children.begin(), child->children.end());
+  }
   return results;
 }
 
@@ -470,33 +1970,392 @@ inline Trie& Trie::operator=(Trie&& trie) noexcept {
  *
  * @param text The word to be inserted into the trie.
  */
-inline void Trie::insert(const std::string& text) { root->insert(text, 0, root); }
+template <typename Alphabet>
+inline void BasicTrie<Alphabet>::insert(const std::string& text) {
+  static_cast<void>(root->insert(text, 0, root));
+}
 
 /**
- * @brief Recursively inserts characters of the string into the trie.
+ * @brief Inserts the words of a string below this node.
  *
- * Inserts characters starting from the specified index. Marks the node as
- * the end of a word if the string ends or encounters a non-alphabetic character.
+ * Walks the characters starting from the specified index, creating missing children. A
+ * character outside of the alphabet, or the end of the string, marks the node reached as the
+ * end of a word; after a separator the next word starts again at the root. The nodes on the
+ * path of each new word are kept in a list, so their word counts can be raised once the word
+ * turns out to be new.
  *
  * @param text The word being inserted.
- * @param index The current index of the character being processed in the word.
- * @param root Pointer to the root node of the trie for recursive insertion.
+ * @param index The index of the first character to insert below this node.
+ * @param root Pointer to the root node of the trie, where the words after a separator start.
+ * @return true if the word ending on the path from this node was not stored before.
  */
-inline void Trie::Node::insert(const std::string& text, const size_t index, Node* root) {
-  if (index == text.size()) {
-    end_of_word = true;
-    return;
+template <typename Alphabet>
+inline bool BasicTrie<Alphabet>::Node::insert(const std::string& text, const size_t index, Node* root) {
+  std::vector<Node*> path;
+  path.reserve(kStackReserve);
+  Node* node = this;
+  bool first_added = false;
+  bool first = true;
+  for (size_t i = index;; ++i) {
+    if (i < text.size() && Alphabet::contains(text[i])) {
+      path.push_back(node);
+      // Create a new node if the current character is not found
+      Node*& child = node->children[text[i]];
+      if (child == nullptr) {
+        child = new Node();
+      }
+      node = child;
+      continue;
+    }
+
+    // Mark as end of word at the end of the text or at a character outside of the alphabet
+    const bool added = !node->end_of_word;
+    node->end_of_word = true;
+    if (added) {
+      path.push_back(node);
+      for (Node* step : path) {
+        ++step->words;
+        step->digest = 0;
+      }
+    }
+    if (first) {
+      first_added = added;
+      first = false;
+    }
+    if (i >= text.size()) {
+      return first_added;
+    }
+    // The following words count themselves on their own path from the root.
+    path.clear();
+    node = root;
   }
+}
 
-  // Mark as end of word if a non-alphabetic character is encountered
-  if (isalpha(text[index]) == 0) {
-    end_of_word = true;
-    root->insert(text, index + 1, root);
-  } else {
-    // Create a new node if the current character is not found
-    if (!children.contains(text[index])) {
-      children[text[index]] = new Node();
+/**
+ * @brief Finds words matching a wildcard pattern.
+ *
+ * Supports `?`/`_` (one character), `*` (any sequence) and character classes such as `[a-c]`
+ * or `[!aeiou]`, see WildcardPattern. Only branches that keep at least one pattern position
+ * alive are visited, and positions with a few literal candidates are followed by direct child
+ * lookups instead of scanning all children.
+ *
+ * @param pattern The wildcard pattern.
+ * @param count The maximum number of words to return.
+ * @return A queue of matching words in lexicographical order.
+ */
+template <typename Alphabet>
+inline std::queue<std::string> BasicTrie<Alphabet>::match(const std::string_view pattern, const size_t count) const {
+  using Iterator = decltype(std::as_const(root->children).begin());
+  // One node on the current path: its DFA state and the next child to try, taken either from the
+  // literal candidates of the state or from the children in order.
+  struct Frame final {
+    std::size_t state;
+    const Node* node;
+    std::string literals;
+    std::size_t literal;
+    Iterator next;
+    Iterator end;
+  };
+
+  std::queue<std::string> results;
+  if (count == 0) {
+    return results;
+  }
+  WildcardPattern automaton(pattern);
+  std::string current;
+  std::vector<Frame> stack;
+  // Records the word at `node` if it matches and opens it; false once `count` words were found.
+  const auto enter = [&](const Node* node, const std::size_t state) {
+    if (node->end_of_word && automaton.accepting(state)) {
+      results.push(current);
+      if (results.size() >= count) {
+        return false;
+      }
+    }
+    // Copied: the automaton may grow (and reallocate its states) while descending.
+    std::string literals = automaton.direct(state) ? automaton.literals(state) : std::string();
+    stack.push_back({state, node, std::move(literals), 0, node->children.begin(), node->children.end()});
+    return true;
+  };
+
+  if (!enter(root, automaton.start())) {
+    return results;
+  }
+  while (!stack.empty()) {
+    Frame& frame = stack.back();
+    const Node* child = nullptr;
+    char key = '\0';
+    if (automaton.direct(frame.state)) {
+      while (child == nullptr && frame.literal < frame.literals.size()) {
+        key = frame.literals[frame.literal++];
+        const auto found = frame.node->children.find(key);
+        child = found != frame.node->children.end() ? found->second : nullptr;
+      }
+    } else if (frame.next != frame.end) {
+      key = (*frame.next).first;
+      child = (*frame.next).second;
+      ++frame.next;
+    }
+
+    if (child == nullptr) {
+      stack.pop_back();
+      if (!stack.empty()) {
+        current.pop_back();
+      }
+      continue;
     }
-    children[text[index]]->insert(text, index + 1, root);
+    const std::size_t next = automaton.next(frame.state, key);
+    if (next == WildcardPattern::kDead) {
+      continue;
+    }
+    current.push_back(key);
+    if (!enter(child, next)) {
+      break;
+    }
+  }
+  return results;
+}
+
+/**
+ * @brief Finds words typed with a digit sequence on a phone keypad, e.g. "4663" -> good, gone, home.
+ *
+ * All letter branches of a digit are expanded in parallel as one frontier per level; a branch is
+ * dropped as soon as its letter does not sit on the next key. Frontier entries only keep a parent
+ * index and a letter, so words are spelled out once, for the final level only.
+ *
+ * @param digits Keys pressed, '2'..'9'.
+ * @param count The maximum number of words to return.
+ * @return Words of exactly `digits.size()` letters in lexicographical order.
+ */
+template <typename Alphabet>
+inline std::queue<std::string> BasicTrie<Alphabet>::t9_lookup(const std::string_view digits,
+                                                              const size_t count) const {
+  struct Step final {
+    const Node* node;
+    size_t parent;
+    char letter;
+  };
+
+  std::queue<std::string> results;
+  if (digits.empty() || count == 0) {
+    return results;
+  }
+
+  std::vector<Step> frontier{{root, 0, '\0'}};
+  size_t level_begin = 0;
+  for (const char digit : digits) {
+    const size_t level_end = frontier.size();
+    for (size_t i = level_begin; i < level_end; ++i) {
+      const Node* node = frontier[i].node;
+      for (const auto& [key, child] : node->children) {
+        if (t9Digit(key) == digit) {
+          frontier.push_back({child, i, key});
+        }
+      }
+    }
+    if (level_end == frontier.size()) {
+      return results;
+    }
+    level_begin = level_end;
+  }
+
+  for (size_t i = level_begin; i < frontier.size() && results.size() < count; ++i) {
+    if (!frontier[i].node->end_of_word) {
+      continue;
+    }
+    std::string word(digits.size(), '\0');
+    for (size_t step = i, position = digits.size(); position > 0; step = frontier[step].parent) {
+      word[--position] = frontier[step].letter;
+    }
+    results.push(std::move(word));
+  }
+  return results;
+}
+
+/**
+ * @brief Resident set size of the process, 0 where it cannot be queried.
+ */
+template <typename Alphabet>
+inline size_t BasicTrie<Alphabet>::residentBytes() {
+#if defined(__linux__)
+  std::ifstream statm("/proc/self/statm");
+  size_t total_pages = 0;
+  size_t resident_pages = 0;
+  if (statm >> total_pages >> resident_pages) {
+    return resident_pages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  }
+#endif
+  return 0;
+}
+
+/**
+ * @brief Asks the allocator to hand free heap pages back to the operating system.
+ *
+ * Walks the whole heap, so on a large one it takes far longer than a compactStep(); call it when
+ * a pause is acceptable, after the pass is complete.
+ */
+template <typename Alphabet>
+inline void BasicTrie<Alphabet>::releaseFreeMemory() {
+#if defined(__GLIBC__)
+  static_cast<void>(malloc_trim(0));
+#endif
+}
+
+/**
+ * @brief Rebuilds all live nodes into a fresh, contiguous depth-first layout.
+ *
+ * After long insert/del churn the nodes are scattered over a fragmented heap. The trie is first
+ * flattened into a compact preorder buffer, every node is freed and the heap is trimmed, then the
+ * nodes are reallocated in preorder, so they come out of coalesced free memory one after another
+ * and a subtree occupies one mostly contiguous range.
+ *
+ * @note Peak memory is the old trie plus a few bytes per node for the buffer.
+ * @return Bytes of resident memory given back to the system (0 if RSS did not shrink).
+ */
+template <typename Alphabet>
+inline size_t BasicTrie<Alphabet>::compact() {
+  struct Entry final {
+    char key;
+    bool end_of_word;
+    std::uint8_t referenced;
+    std::uint8_t uses;
+    std::uint8_t best;
+    std::uint32_t children;
+    std::uint32_t words;
+    std::uint64_t digest;
+    std::unique_ptr<std::string> forms;
+  };
+
+  const size_t before = residentBytes();
+
+  std::vector<Entry> preorder;
+  preorder.reserve(size() + 1);
+  std::vector<std::pair<Node*, char>> pending{{root, '\0'}};
+  std::vector<std::pair<Node*, char>> children;
+  while (!pending.empty()) {
+    const auto [node, key] = pending.back();
+    pending.pop_back();
+    preorder.push_back({key, node->end_of_word, node->referenced, node->uses, node->best,
+                        static_cast<std::uint32_t>(node->children.size()), node->words, node->digest,
+                        std::move(node->forms)});
+
+    children.clear();
+    for (const auto& [child_key, child] : node->children) {
+      children.emplace_back(child, child_key);
+    }
+    pending.insert(pending.end(), children.rbegin(), children.rend());
+  }
+
+  delete root;
+  compaction.clear();
+  releaseFreeMemory();
+
+  root = new Node();
+  root->end_of_word = preorder.front().end_of_word;
+  root->referenced = preorder.front().referenced;
+  root->uses = preorder.front().uses;
+  root->best = preorder.front().best;
+  root->words = preorder.front().words;
+  root->digest = preorder.front().digest;
+  root->forms = std::move(preorder.front().forms);
+  std::vector<std::pair<Node*, std::uint32_t>> building{{root, preorder.front().children}};
+  for (size_t i = 1; i < preorder.size(); ++i) {
+    while (building.back().second == 0) {
+      building.pop_back();
+    }
+    --building.back().second;
+
+    Node* node = new Node();
+    node->end_of_word = preorder[i].end_of_word;
+    node->referenced = preorder[i].referenced;
+    node->uses = preorder[i].uses;
+    node->best = preorder[i].best;
+    node->words = preorder[i].words;
+    node->digest = preorder[i].digest;
+    node->forms = std::move(preorder[i].forms);
+    building.back().first->children[preorder[i].key] = node;
+    building.emplace_back(node, preorder[i].children);
+  }
+
+  preorder = std::vector<Entry>();
+  releaseFreeMemory();
+  const size_t after = residentBytes();
+  return before > after ? before - after : 0;
+}
+
+/**
+ * @brief Incremental, online variant of compact(): relocates at most `budget` nodes per call.
+ *
+ * Nodes are copied in preorder into fresh allocations, together with their child containers.
+ * The old copies are kept until every node has moved, so that no copy lands in a scattered slot
+ * they would free; the following steps then free them, again `budget` at a time. The position of
+ * the pass is kept as a stack of pending paths that are resolved from the root on every call, so
+ * insert() and del() may run between steps; nodes created after the pass went by are simply left
+ * where they are. No step trims the heap: the freed memory stays with the allocator and is reused
+ * by later allocations until the caller schedules releaseFreeMemory().
+ *
+ * @note While a pass runs, the old and the new copy of every node are resident.
+ *
+ * @param budget The maximum number of nodes to relocate in this call.
+ * @return true when the pass is complete; the next call starts a new pass.
+ */
+template <typename Alphabet>
+inline bool BasicTrie<Alphabet>::compactStep(size_t budget) {
+  if (compaction.empty() && relocated.empty()) {
+    // Sized up front, so that the growth of the stack does not interleave with the copies.
+    compaction.reserve(256);
+    compaction.emplace_back();
+  }
+
+  while (budget > 0 && !compaction.empty()) {
+    const std::string path = std::move(compaction.back());
+    compaction.pop_back();
+
+    Node* parent = nullptr;
+    Node* node = root;
+    if (!path.empty()) {
+      parent = findNode(std::string_view(path).substr(0, path.size() - 1));
+      if (parent == nullptr || !parent->children.contains(path.back())) {
+        continue;
+      }
+      node = parent->children[path.back()];
+    }
+
+    Node* fresh = new Node();
+    fresh->end_of_word = node->end_of_word;
+    fresh->referenced = node->referenced;
+    fresh->uses = node->uses;
+    fresh->best = node->best;
+    fresh->words = node->words;
+    fresh->digest = node->digest;
+    fresh->forms = std::move(node->forms);
+    fresh->children = node->children;
+    relocated.push_back(node);
+    if (parent == nullptr) {
+      root = fresh;
+    } else {
+      parent->children[path.back()] = fresh;
+    }
+    --budget;
+
+    const size_t first = compaction.size();
+    for (const auto& [key, child] : fresh->children) {
+      compaction.push_back(path + key);
+    }
+    std::reverse(compaction.begin() + static_cast<std::ptrdiff_t>(first), compaction.end());
+  }
+
+  while (budget > 0 && compaction.empty() && !relocated.empty()) {
+    relocated.back()->children.clear();
+    delete relocated.back();
+    relocated.pop_back();
+    --budget;
+  }
+
+  if (!compaction.empty() || !relocated.empty()) {
+    return false;
   }
+  compaction = {};
+  relocated = {};
+  return true;
 }
@@ -0,0 +1,213 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Trie.h"
+
+/**
+ * @brief Publishes immutable trie versions to concurrent readers and swaps them without downtime.
+ *
+ * Readers pin the current version with read(); the returned Snapshot stays valid for as long as it
+ * lives, whatever is published meanwhile. Pinning is lock-free: the reader claims a hazard slot
+ * and announces the version it is about to use, so a reader never waits for a writer.
+ *
+ * Writers build the next version off to the side (reload() does it on a background thread),
+ * then publish() swaps it in with one atomic exchange. The old version is retired and deleted
+ * once no hazard slot refers to it any more; until then both versions are resident.
+ *
+ * @note At most kSlots snapshots can be pinned at the same time; further readers spin until a
+ *       slot is released.
+ */
+template <typename Alphabet = CharAlphabet>
+class BasicTrieHolder final {
+  struct alignas(64) Slot final {
+    std::atomic<bool> claimed{false};
+    std::atomic<const BasicTrie<Alphabet>*> hazard{nullptr};
+  };
+
+public:
+  static constexpr size_t kSlots = 128;
+
+  class Snapshot final {
+  public:
+    Snapshot(Snapshot&& other) noexcept : slot(std::exchange(other.slot, nullptr)), trie(other.trie) {}
+    Snapshot(const Snapshot&) = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+    Snapshot& operator=(Snapshot&&) = delete;
+    ~Snapshot();
+
+    const BasicTrie<Alphabet>& operator*() const noexcept { return *trie; }
+    const BasicTrie<Alphabet>* operator->() const noexcept { return trie; }
+
+  private:
+    friend class BasicTrieHolder;
+    Snapshot(Slot* slot, const BasicTrie<Alphabet>* trie) : slot(slot), trie(trie) {}
+
+    Slot* slot;
+    const BasicTrie<Alphabet>* trie;
+  };
+
+  BasicTrieHolder() : current(new BasicTrie<Alphabet>()) {}
+  explicit BasicTrieHolder(BasicTrie<Alphabet> trie) : current(new BasicTrie<Alphabet>(std::move(trie))) {}
+  ~BasicTrieHolder();
+  BasicTrieHolder(const BasicTrieHolder&) = delete;
+  BasicTrieHolder& operator=(const BasicTrieHolder&) = delete;
+
+  [[nodiscard]] Snapshot read() const;
+  void publish(BasicTrie<Alphabet> trie);
+  [[nodiscard]] std::future<bool> reload(std::string path);
+  size_t reclaim();
+
+private:
+  void retire(const BasicTrie<Alphabet>* trie);
+
+  std::atomic<const BasicTrie<Alphabet>*> current;
+  mutable std::array<Slot, kSlots> slots{};
+  std::mutex writer;
+  std::vector<const BasicTrie<Alphabet>*> retired;
+};
+
+using TrieHolder = BasicTrieHolder<CharAlphabet>;
+
+/**
+ * @brief Releases the hazard slot; the pinned version may be reclaimed afterwards.
+ */
+template <typename Alphabet>
+inline BasicTrieHolder<Alphabet>::Snapshot::~Snapshot() {
+  if (slot != nullptr) {
+    slot->hazard.store(nullptr, std::memory_order_release);
+    slot->claimed.store(false, std::memory_order_release);
+  }
+}
+
+/**
+ * @brief Deletes the current version and every retired one.
+ * @warning No Snapshot of this holder may outlive it.
+ */
+template <typename Alphabet>
+inline BasicTrieHolder<Alphabet>::~BasicTrieHolder() {
+  for (const BasicTrie<Alphabet>* trie : retired) {
+    delete trie;
+  }
+  delete current.load();
+}
+
+/**
+ * @brief Pins the current version for reading.
+ *
+ * Claims a free hazard slot (starting from a per-thread hint), then stores the current pointer
+ * in it and re-reads `current` to make sure the version was not retired in between.
+ *
+ * @return RAII handle to the pinned trie.
+ */
+template <typename Alphabet>
+inline typename BasicTrieHolder<Alphabet>::Snapshot BasicTrieHolder<Alphabet>::read() const {
+  static thread_local const size_t hint = std::hash<std::thread::id>{}(std::this_thread::get_id()) % kSlots;
+
+  Slot* slot = nullptr;
+  for (size_t i = hint;; i = (i + 1) % kSlots) {
+    if (!slots[i].claimed.load(std::memory_order_relaxed) &&
+        !slots[i].claimed.exchange(true, std::memory_order_acquire)) {
+      slot = &slots[i];
+      break;
+    }
+  }
+
+  const BasicTrie<Alphabet>* trie = current.load(std::memory_order_acquire);
+  while (true) {
+    slot->hazard.store(trie, std::memory_order_seq_cst);
+    const BasicTrie<Alphabet>* again = current.load(std::memory_order_seq_cst);
+    if (again == trie) {
+      break;
+    }
+    trie = again;
+  }
+  return Snapshot(slot, trie);
+}
+
+/**
+ * @brief Atomically replaces the published version.
+ *
+ * Readers that already pinned the old version keep using it; new readers see `trie`.
+ *
+ * @param trie The new version.
+ */
+template <typename Alphabet>
+inline void BasicTrieHolder<Alphabet>::publish(BasicTrie<Alphabet> trie) {
+  const auto* next = new BasicTrie<Alphabet>(std::move(trie));
+  std::lock_guard lock(writer);
+  retire(current.exchange(next, std::memory_order_seq_cst));
+}
+
+/**
+ * @brief Builds a new version from a word list on a background thread and publishes it.
+ *
+ * The file is read with the same rules as the loader in src/main.cc. Readers keep being served
+ * from the current version during the build.
+ *
+ * @param path Word list to load.
+ * @return Future that becomes true once the new version is published, false if the file could not be opened.
+ */
+template <typename Alphabet>
+inline std::future<bool> BasicTrieHolder<Alphabet>::reload(std::string path) {
+  return std::async(std::launch::async, [this, path = std::move(path)] {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+      return false;
+    }
+    BasicTrie<Alphabet> next;
+    std::string line;
+    while (std::getline(file, line)) {
+      next.insert(line);
+    }
+    publish(std::move(next));
+    return true;
+  });
+}
+
+/**
+ * @brief Deletes retired versions that are no longer pinned.
+ * @return Number of retired versions still waiting for readers.
+ */
+template <typename Alphabet>
+inline size_t BasicTrieHolder<Alphabet>::reclaim() {
+  std::lock_guard lock(writer);
+  retire(nullptr);
+  return retired.size();
+}
+
+/**
+ * @brief Adds a version to the retired list and frees every retired version without a hazard.
+ * @param trie Version to retire, or nullptr to only scan.
+ */
+template <typename Alphabet>
+inline void BasicTrieHolder<Alphabet>::retire(const BasicTrie<Alphabet>* trie) {
+  if (trie != nullptr) {
+    retired.push_back(trie);
+  }
+
+  std::vector<const BasicTrie<Alphabet>*> pinned;
+  for (const Slot& slot : slots) {
+    if (const auto* hazard = slot.hazard.load(std::memory_order_seq_cst); hazard != nullptr) {
+      pinned.push_back(hazard);
+    }
+  }
+
+  std::erase_if(retired, [&](const BasicTrie<Alphabet>* candidate) {
+    if (std::find(pinned.begin(), pinned.end(), candidate) != pinned.end()) {
+      return false;
+    }
+    delete candidate;
+    return true;
+  });
+}
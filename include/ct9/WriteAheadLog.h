@@ -0,0 +1,425 @@
+#pragma once
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+
+#include "Trie.h"
+
+/**
+ * @brief Append-only, group-committed log of trie insertions and deletions.
+ *
+ * A durable dictionary is a base snapshot (a plain word list, one word per line) plus this log.
+ * insert() and del() only append a record to an in-memory batch; a background thread writes the
+ * batch and fsyncs it once it holds `batch_records` records or `batch_interval` has passed, so a
+ * keystroke never waits for the disk. sync() blocks until everything appended so far is durable.
+ *
+ * If a batch cannot be written or fsynced, the log is cut back to where the batch started and the
+ * batch is kept and retried on the next commit; sync() reports the failure instead of waiting.
+ *
+ * Records are `op (1 byte) | length (4 bytes, LE) | text | FNV-1a checksum (4 bytes, LE)`.
+ * A torn or corrupted tail left by a crash is detected on replay and cut off.
+ *
+ * Replaying the log over a newer snapshot gives the same words, because inserts and deletes are
+ * idempotent and the last operation on a word wins. compact() relies on this: it writes a new
+ * snapshot first and only then truncates the log.
+ *
+ * @note insert(), del() and compact() are meant to be called from a single writer thread.
+ */
+class WriteAheadLog final {
+public:
+  struct Options final {
+    size_t batch_records{64};
+    std::chrono::milliseconds batch_interval{100};
+    size_t compact_records{100000};
+    bool fsync{true};
+  };
+
+  WriteAheadLog(std::string snapshot_path, std::string log_path);
+  WriteAheadLog(std::string snapshot_path, std::string log_path, Options options);
+  ~WriteAheadLog();
+  WriteAheadLog(const WriteAheadLog&) = delete;
+  WriteAheadLog& operator=(const WriteAheadLog&) = delete;
+
+  [[nodiscard]] bool isOpen() const noexcept { return fd >= 0; }
+
+  template <typename Alphabet>
+  bool loadSnapshot(BasicTrie<Alphabet>& trie) const;
+  template <typename Alphabet>
+  size_t replay(BasicTrie<Alphabet>& trie);
+  template <typename Alphabet>
+  bool compact(const BasicTrie<Alphabet>& trie);
+
+  void insert(const std::string& text) { append(kInsert, text); }
+  void del(const std::string& word) { append(kDelete, word); }
+  bool sync();
+
+  [[nodiscard]] size_t records() const;
+  [[nodiscard]] bool needsCompaction() const { return records() >= options.compact_records; }
+
+private:
+  static constexpr char kInsert = '+';
+  static constexpr char kDelete = '-';
+
+  [[nodiscard]] static std::uint32_t checksum(char op, const std::string& text);
+  static void putWord(std::string& out, std::uint32_t value);
+  [[nodiscard]] static std::uint32_t getWord(const char* in);
+
+  void append(char op, const std::string& text);
+  void flusher();
+  bool writeAll(const std::string& data) const;
+  bool commit(const std::string& data) const;
+
+  std::string snapshot_path;
+  std::string log_path;
+  Options options;
+  int fd{-1};
+
+  mutable std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable durable;
+  std::string batch;
+  size_t batch_size{0};
+  std::uint64_t appended{0};
+  std::uint64_t persisted{0};
+  std::uint64_t attempts{0};
+  bool failed{false};
+  size_t logged{0};
+  bool sync_requested{false};
+  bool stopping{false};
+  std::mutex io;
+  std::thread worker;
+};
+
+inline WriteAheadLog::WriteAheadLog(std::string snapshot_path, std::string log_path)
+    : WriteAheadLog(std::move(snapshot_path), std::move(log_path), Options{}) {}
+
+/**
+ * @brief Opens (or creates) the log for appending and starts the group-commit thread.
+ * @param snapshot_path Path of the base snapshot.
+ * @param log_path Path of the log file.
+ * @param options Batching and compaction settings.
+ */
+inline WriteAheadLog::WriteAheadLog(std::string snapshot_path, std::string log_path, Options options)
+    : snapshot_path(std::move(snapshot_path)), log_path(std::move(log_path)), options(options) {
+  fd = ::open(this->log_path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+  if (fd >= 0) {
+    worker = std::thread(&WriteAheadLog::flusher, this);
+  }
+}
+
+/**
+ * @brief Commits the pending batch and closes the log.
+ */
+inline WriteAheadLog::~WriteAheadLog() {
+  if (fd < 0) {
+    return;
+  }
+  {
+    std::lock_guard lock(mutex);
+    stopping = true;
+  }
+  wake.notify_all();
+  worker.join();
+  ::close(fd);
+}
+
+/**
+ * @brief FNV-1a over the operation and the text of a record.
+ */
+inline std::uint32_t WriteAheadLog::checksum(const char op, const std::string& text) {
+  std::uint32_t hash = 2166136261u;
+  hash = (hash ^ static_cast<unsigned char>(op)) * 16777619u;
+  for (const char character : text) {
+    hash = (hash ^ static_cast<unsigned char>(character)) * 16777619u;
+  }
+  return hash;
+}
+
+inline void WriteAheadLog::putWord(std::string& out, const std::uint32_t value) {
+  for (int shift = 0; shift < 32; shift += 8) {
+    out.push_back(static_cast<char>((value >> shift) & 0xFFu));
+  }
+}
+
+inline std::uint32_t WriteAheadLog::getWord(const char* in) {
+  std::uint32_t value = 0;
+  for (int i = 3; i >= 0; --i) {
+    value = (value << 8) | static_cast<unsigned char>(in[i]);
+  }
+  return value;
+}
+
+/**
+ * @brief Adds a record to the current batch and wakes the committer if the batch is full.
+ * @param op Operation tag.
+ * @param text Argument of the operation.
+ */
+inline void WriteAheadLog::append(const char op, const std::string& text) {
+  if (fd < 0) {
+    return;
+  }
+  bool full = false;
+  {
+    std::lock_guard lock(mutex);
+    batch.push_back(op);
+    putWord(batch, static_cast<std::uint32_t>(text.size()));
+    batch += text;
+    putWord(batch, checksum(op, text));
+    ++appended;
+    ++logged;
+    full = ++batch_size >= options.batch_records;
+  }
+  if (full) {
+    wake.notify_one();
+  }
+}
+
+/**
+ * @brief Blocks until every record appended so far has been written (and fsynced if enabled).
+ * @return true if the records are durable; false if the log is closed or a commit attempt made
+ *         after this call failed. The records stay queued and are retried with the next commit.
+ */
+inline bool WriteAheadLog::sync() {
+  if (fd < 0) {
+    return false;
+  }
+  std::unique_lock lock(mutex);
+  const std::uint64_t target = appended;
+  const std::uint64_t attempted = attempts;
+  sync_requested = true;
+  wake.notify_one();
+  durable.wait(lock, [&] { return persisted >= target || (failed && attempts > attempted); });
+  return persisted >= target;
+}
+
+/**
+ * @brief Number of records in the log since the last compaction.
+ */
+inline size_t WriteAheadLog::records() const {
+  std::lock_guard lock(mutex);
+  return logged;
+}
+
+inline bool WriteAheadLog::writeAll(const std::string& data) const {
+  size_t written = 0;
+  while (written < data.size()) {
+    const ssize_t result = ::write(fd, data.data() + written, data.size() - written);
+    if (result < 0 && errno == EINTR) {
+      continue;
+    }
+    if (result <= 0) {
+      return false;
+    }
+    written += static_cast<size_t>(result);
+  }
+  return true;
+}
+
+/**
+ * @brief Appends a batch and fsyncs it; on failure cuts the log back to where the batch started.
+ *
+ * A partly written batch would leave a torn record in the middle of the log, and replay() drops
+ * everything after the first bad record, including batches that are committed later.
+ *
+ * @return true if the whole batch is durable. Call with `io` held.
+ */
+inline bool WriteAheadLog::commit(const std::string& data) const {
+  const off_t start = ::lseek(fd, 0, SEEK_END);
+  if (start < 0) {
+    std::perror("ct9 write-ahead log");
+    return false;
+  }
+  if (writeAll(data) && (!options.fsync || ::fdatasync(fd) == 0)) {
+    return true;
+  }
+  std::perror("ct9 write-ahead log");
+  while (::ftruncate(fd, start) != 0 && errno == EINTR) {
+  }
+  return false;
+}
+
+/**
+ * @brief Group-commit loop: takes the whole batch, writes it with one write() and one fsync().
+ *
+ * A batch that fails is put back in front of the records appended meanwhile and retried on the
+ * next round; `persisted` only advances past records that were committed.
+ */
+inline void WriteAheadLog::flusher() {
+  std::unique_lock lock(mutex);
+  while (true) {
+    // After a failed commit a full batch does not cut the wait short, so a broken disk is not hammered.
+    wake.wait_for(lock, options.batch_interval, [&] {
+      return stopping || sync_requested || (!failed && batch_size >= options.batch_records);
+    });
+    if (batch.empty()) {
+      sync_requested = false;
+      durable.notify_all();
+      if (stopping) {
+        return;
+      }
+      continue;
+    }
+
+    std::string pending;
+    pending.swap(batch);
+    const size_t pending_size = batch_size;
+    batch_size = 0;
+    sync_requested = false;
+    const std::uint64_t target = appended;
+    lock.unlock();
+
+    bool committed = false;
+    {
+      std::lock_guard io_lock(io);
+      committed = commit(pending);
+    }
+
+    lock.lock();
+    ++attempts;
+    failed = !committed;
+    if (committed) {
+      persisted = target;
+    } else {
+      batch.insert(0, pending);
+      batch_size += pending_size;
+    }
+    durable.notify_all();
+    if (!committed && stopping) {
+      return;
+    }
+  }
+}
+
+/**
+ * @brief Loads the base snapshot into a trie.
+ * @param trie Destination trie.
+ * @return true if a snapshot exists and was loaded.
+ */
+template <typename Alphabet>
+inline bool WriteAheadLog::loadSnapshot(BasicTrie<Alphabet>& trie) const {
+  std::ifstream file(snapshot_path);
+  if (!file.is_open()) {
+    return false;
+  }
+  std::string line;
+  while (std::getline(file, line)) {
+    trie.insert(line);
+  }
+  return true;
+}
+
+/**
+ * @brief Applies every intact record of the log to a trie.
+ *
+ * Stops at the first truncated or corrupted record and cuts the log there, so that records
+ * appended afterwards stay reachable. Call before the first insert()/del().
+ *
+ * @param trie Trie holding the base snapshot.
+ * @return Number of records applied.
+ */
+template <typename Alphabet>
+inline size_t WriteAheadLog::replay(BasicTrie<Alphabet>& trie) {
+  std::ifstream file(log_path, std::ios::binary);
+  const std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+  size_t offset = 0;
+  size_t applied = 0;
+  while (offset + 9 <= data.size()) {
+    const char op = data[offset];
+    const std::uint32_t length = getWord(data.data() + offset + 1);
+    if ((op != kInsert && op != kDelete) || data.size() - offset - 9 < length) {
+      break;
+    }
+    const std::string text = data.substr(offset + 5, length);
+    if (getWord(data.data() + offset + 5 + length) != checksum(op, text)) {
+      break;
+    }
+
+    if (op == kInsert) {
+      trie.insert(text);
+    } else {
+      trie.del(text);
+    }
+    offset += 9 + length;
+    ++applied;
+  }
+
+  if (offset != data.size() && fd >= 0) {
+    std::lock_guard io_lock(io);
+    static_cast<void>(::ftruncate(fd, static_cast<off_t>(offset)));
+  }
+  std::lock_guard lock(mutex);
+  logged = applied;
+  return applied;
+}
+
+/**
+ * @brief Writes the trie as the new base snapshot and empties the log.
+ *
+ * The snapshot is written to a temporary file, fsynced and renamed over the old one before the
+ * log is truncated, so a crash at any point leaves a snapshot + log pair that replays correctly.
+ *
+ * @param trie Current state, including every record appended so far.
+ * @return true on success; on failure the old snapshot and the log are left untouched.
+ */
+template <typename Alphabet>
+inline bool WriteAheadLog::compact(const BasicTrie<Alphabet>& trie) {
+  if (fd < 0 || !sync()) {
+    return false;
+  }
+
+  const std::string temporary = snapshot_path + ".tmp";
+  {
+    std::ofstream file(temporary, std::ios::trunc);
+    std::queue<std::string> words = trie.autocomplete("", INT_MAX);
+    while (!words.empty()) {
+      file << words.front() << '\n';
+      words.pop();
+    }
+    file.flush();
+    if (!file.good()) {
+      return false;
+    }
+  }
+
+  const int snapshot_fd = ::open(temporary.c_str(), O_RDONLY | O_CLOEXEC);
+  if (snapshot_fd < 0) {
+    return false;
+  }
+  const bool flushed = ::fsync(snapshot_fd) == 0;
+  ::close(snapshot_fd);
+  if (!flushed || std::rename(temporary.c_str(), snapshot_path.c_str()) != 0) {
+    return false;
+  }
+  // Make the rename itself durable before the log that it supersedes disappears.
+  const std::filesystem::path directory = std::filesystem::path(snapshot_path).parent_path();
+  const int directory_fd = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY | O_CLOEXEC);
+  if (directory_fd >= 0) {
+    ::fsync(directory_fd);
+    ::close(directory_fd);
+  }
+
+  std::lock_guard io_lock(io);
+  if (::ftruncate(fd, 0) != 0) {
+    return false;
+  }
+  if (options.fsync && ::fdatasync(fd) != 0) {
+    return false;
+  }
+  std::lock_guard lock(mutex);
+  logged = batch_size;
+  return true;
+}
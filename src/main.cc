@@ -1,12 +1,39 @@
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <iterator>
+#include <optional>
+#include <vector>
 
+#include "../include/ct9/BatchQuery.h"
+#include "../include/ct9/Replication.h"
 #include "../include/ct9/Trie.h"
+#include "../include/ct9/WriteAheadLog.h"
+
+// Words added at runtime are persisted as a snapshot plus a write-ahead log.
+#define WAL_SNAPSHOT "ct9.snapshot"
+#define WAL_LOG "ct9.wal"
+
+// Upper bound on the time one keystroke may spend walking the runtime trie.
+#define SUGGEST_DEADLINE std::chrono::milliseconds(2)
+
+// Suggestions per query in batch mode, unless --count is given.
+#define BATCH_SUGGESTIONS 5
+
+#if CT9_STATIC_DICTIONARY
+#include <ct9/Dictionary.h>
+#endif
 
 #if BUILD_GUI
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
+#include <poll.h>
+
+#include "../include/ct9/SuggestionWorker.h"
 #define POSX 100
 #define POSY 100
 #define WIDTH 400
@@ -17,23 +44,188 @@
 
 #define TEXTBOX_MAX_CHARS 32
 
+// Pace of the keys typed by CT9_REPLAY.
+#define REPLAY_INTERVAL std::chrono::milliseconds(50)
+
 static Display* dpy;
 static Window root;
 static int screen;
 #endif
 
-int main() {
-  Trie t{};
-  std::ifstream file("../tests/words.txt");
+/**
+ * @brief Autocompletes a prefix against the runtime trie and, if present, the embedded dictionary.
+ *
+ * Both sources return words in lexicographical order, so the results are merged in that order.
+ * The walk of the runtime trie stops when `budget` runs out, returning the words found until then.
+ */
+static std::queue<std::string> complete(const Trie& t, const std::string& prefix, const size_t count,
+                                        const Trie::Budget& budget) {
+  std::string cursor;
+#if CT9_STATIC_DICTIONARY
+  std::queue<std::string> runtime_words = t.autocomplete(prefix, count, budget, cursor);
+  std::queue<std::string> static_words = kDictionary.autocomplete(prefix, count);
+  std::queue<std::string> result;
+  while (result.size() < count && (!runtime_words.empty() || !static_words.empty())) {
+    if (static_words.empty() || (!runtime_words.empty() && runtime_words.front() < static_words.front())) {
+      result.push(std::move(runtime_words.front()));
+      runtime_words.pop();
+    } else {
+      if (!runtime_words.empty() && runtime_words.front() == static_words.front()) {
+        runtime_words.pop();
+      }
+      result.push(std::move(static_words.front()));
+      static_words.pop();
+    }
+  }
+  return result;
+#else
+  return t.autocomplete(prefix, count, budget, cursor);
+#endif
+}
 
-  if (!file.is_open()) {
+/**
+ * @brief Suggestions for a prefix: words accepted with Tab before, most used first, then complete().
+ *
+ * Only words of the runtime trie learn from use; the embedded dictionary is read-only.
+ */
+static std::queue<std::string> suggest(const Trie& t, const std::string& prefix, const size_t count,
+                                       const Trie::Budget& budget) {
+  std::queue<std::string> result = t.frequent(prefix, count);
+  if (result.size() >= count) {
+    return result;
+  }
+  std::vector<std::string> learned;
+  for (std::queue<std::string> copy = result; !copy.empty(); copy.pop()) {
+    learned.push_back(copy.front());
+  }
+  std::queue<std::string> rest = complete(t, prefix, count + learned.size(), budget);
+  for (; result.size() < count && !rest.empty(); rest.pop()) {
+    if (std::find(learned.begin(), learned.end(), rest.front()) == learned.end()) {
+      result.push(std::move(rest.front()));
+    }
+  }
+  return result;
+}
+
+/**
+ * @brief Budget of one interactive keystroke: the runtime trie is walked for at most SUGGEST_DEADLINE.
+ */
+static Trie::Budget keystroke() { return {SIZE_MAX, std::chrono::steady_clock::now() + SUGGEST_DEADLINE}; }
+
+/**
+ * @brief Batch mode: `ct9 --batch <file> [--threads N] [--count K]`.
+ *
+ * Answers every line of the file as a prefix, without a deadline, on a pool of threads, and writes
+ * one line per prefix to stdout in input order: the prefix and its suggestions, tab-separated.
+ * Throughput and latency percentiles go to stderr.
+ */
+static int batch(const Trie& t, const int argc, char** argv) {
+  BatchQuery::Options options;
+  size_t count = BATCH_SUGGESTIONS;
+  for (int i = 3; i + 1 < argc; i += 2) {
+    const std::string flag = argv[i];
+    if (flag == "--threads") {
+      options.threads = std::strtoul(argv[i + 1], nullptr, 10);
+    } else if (flag == "--count") {
+      count = std::strtoul(argv[i + 1], nullptr, 10);
+    }
+  }
+
+  const MappedFile input(argv[2]);
+  if (!input.isOpen()) {
+    std::cerr << "File opening error.\n";
+    return EXIT_FAILURE;
+  }
+  const BatchQuery::Report report = BatchQuery(options).run(
+      input.view(), STDOUT_FILENO, [&](const std::string& prefix) { return suggest(t, prefix, count, {}); });
+  std::cerr << report.queries << " queries in " << report.seconds << " s (" << report.throughput()
+            << " queries/s); latency (us): p50 " << report.p50 << ", p90 " << report.p90 << ", p99 " << report.p99
+            << ", p99.9 " << report.p999 << ", max " << report.max << '\n';
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Follower mode: `ct9 --follow <stream> [--count K]`.
+ *
+ * Keeps a replica of the runtime words of a leader started with CT9_PUBLISH=<stream>, where the
+ * stream is a file or a FIFO, and answers prefixes read from stdin, one per line, in the format of
+ * batch mode. Frames that arrived in the meantime are applied before every answer.
+ */
+static int follow(const int argc, char** argv) {
+  size_t count = BATCH_SUGGESTIONS;
+  if (argc >= 5 && std::string(argv[3]) == "--count") {
+    count = std::strtoul(argv[4], nullptr, 10);
+  }
+  const int fd = ::open(argv[2], O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+  if (fd < 0) {
     std::cerr << "File opening error.\n";
     return EXIT_FAILURE;
   }
 
-  std::string line;
-  while (std::getline(file, line)) {
-    t.insert(line);
+  ReplicaFollower follower(fd);
+  bool warned = false;
+  std::string prefix;
+  while (std::getline(std::cin, prefix)) {
+    static_cast<void>(follower.pump());
+    if (!follower.inSync() && !warned) {
+      std::cerr << "Replica is out of sync with the leader; restart the leader to resend every word.\n";
+      warned = true;
+    }
+    std::cout << prefix;
+    for (std::queue<std::string> words = suggest(follower.words(), prefix, count, {}); !words.empty(); words.pop()) {
+      std::cout << '\t' << words.front();
+    }
+    std::cout << std::endl;
+  }
+  ::close(fd);
+  return EXIT_SUCCESS;
+}
+
+int main(int argc, char** argv) {
+  if (argc >= 3 && std::string(argv[1]) == "--follow") {
+    return follow(argc, argv);
+  }
+
+  Trie t{};
+  WriteAheadLog wal(WAL_SNAPSHOT, WAL_LOG);
+  if (!wal.isOpen()) {
+    std::cerr << "Write-ahead log unavailable, added words will not be saved.\n";
+  }
+
+#if !CT9_STATIC_DICTIONARY
+  if (!wal.loadSnapshot(t)) {
+    std::ifstream file("../tests/words.txt");
+
+    if (!file.is_open()) {
+      std::cerr << "File opening error.\n";
+      return EXIT_FAILURE;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+      t.insert(line);
+    }
+    file.close();
+  }
+#else
+  static_cast<void>(wal.loadSnapshot(t));
+#endif
+  static_cast<void>(wal.replay(t));
+
+  if (argc >= 3 && std::string(argv[1]) == "--batch") {
+    return batch(t, argc, argv);
+  }
+
+  // CT9_PUBLISH=<file or FIFO> streams every change of the runtime words to `ct9 --follow` processes.
+  std::optional<ReplicaPublisher> publisher;
+  if (const char* publish_path = std::getenv("CT9_PUBLISH"); publish_path != nullptr) {
+    const int fd = ::open(publish_path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd >= 0) {
+      publisher.emplace(fd);
+      static_cast<void>(publisher->publish(t));
+    } else {
+      std::cerr << "Cannot open " << publish_path << ", replication is off.\n";
+    }
   }
 
 #if BUILD_GUI
@@ -86,22 +278,100 @@ int main() {
   }
   XSetFont(dpy, gc, fontInfo->fid);
 
-  // Result of autocompletion
-  std::queue<std::string> words;
+  // Suggestions are computed on a worker thread that also owns every write to the trie.
+  SuggestionWorker worker([&t](const std::string& prefix) { return suggest(t, prefix, 1, keystroke()); });
+  std::uint64_t latest = worker.request(inputText);
+  std::string suggestion;
+
+  const auto redraw = [&] {
+    XClearWindow(dpy, win);
+    if (suggestion.size() > inputText.size() && suggestion.starts_with(inputText)) {
+      XSetForeground(dpy, gc, color_suggestion.pixel);
+      XDrawString(dpy, win, gc, TEXTBOX_X, TEXTBOX_Y, suggestion.c_str(), static_cast<int>(suggestion.size()));
+    }
+    XSetForeground(dpy, gc, color_input.pixel);
+    XDrawString(dpy, win, gc, TEXTBOX_X, TEXTBOX_Y, inputText.c_str(), static_cast<int>(inputText.size()));
+    XFlush(dpy);
+  };
+
+  // Keypress-to-draw latency: from reading a KeyPress to drawing the suggestion for the input it produced.
+  const char* replay_path = std::getenv("CT9_REPLAY");
+  const bool measure_latency = replay_path != nullptr || std::getenv("CT9_LATENCY") != nullptr;
+  std::vector<std::chrono::steady_clock::time_point> waiting;
+  std::vector<double> latencies;
+
+  // CT9_REPLAY=<file> types the file into the window, one key every REPLAY_INTERVAL, then exits.
+  std::string replay;
+  if (replay_path != nullptr) {
+    std::ifstream file(replay_path);
+    replay.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+  size_t replayed = 0;
+  auto next_key = std::chrono::steady_clock::now() + REPLAY_INTERVAL;
+  const auto typeKey = [&](const char character) {
+    const KeySym keysym = character == '\n' ? XK_Return : static_cast<KeySym>(std::tolower(character));
+    XEvent key{};
+    key.xkey.type = KeyPress;
+    key.xkey.display = dpy;
+    key.xkey.window = win;
+    key.xkey.root = root;
+    key.xkey.same_screen = True;
+    key.xkey.keycode = XKeysymToKeycode(dpy, keysym);
+    key.xkey.state = std::isupper(static_cast<unsigned char>(character)) ? ShiftMask : 0;
+    XSendEvent(dpy, win, True, KeyPressMask, &key);
+    XFlush(dpy);
+  };
 
   bool running = true;
   while (running) {
+    if (XPending(dpy) == 0) {
+      int timeout = -1;
+      if (replay_path != nullptr) {
+        const auto now = std::chrono::steady_clock::now();
+        timeout = now >= next_key ? 0
+                                  : static_cast<int>(
+                                        std::chrono::ceil<std::chrono::milliseconds>(next_key - now).count());
+      }
+      pollfd descriptors[2] = {{ConnectionNumber(dpy), POLLIN, 0}, {worker.fd(), POLLIN, 0}};
+      static_cast<void>(poll(descriptors, 2, timeout));
+
+      if ((descriptors[1].revents & POLLIN) != 0) {
+        auto result = worker.take();
+        if (result.has_value() && result->ticket == latest) {
+          suggestion = result->words.empty() ? std::string() : std::move(result->words.front());
+          redraw();
+          if (measure_latency) {
+            XSync(dpy, False);
+            const auto drawn = std::chrono::steady_clock::now();
+            for (const auto pressed : waiting) {
+              latencies.push_back(std::chrono::duration<double, std::micro>(drawn - pressed).count());
+            }
+            waiting.clear();
+          }
+        }
+      }
+
+      if (replay_path != nullptr && std::chrono::steady_clock::now() >= next_key) {
+        if (replayed < replay.size()) {
+          typeKey(replay[replayed++]);
+        } else if (waiting.empty()) {
+          running = false;
+        }
+        next_key += REPLAY_INTERVAL;
+      }
+      continue;
+    }
+
     XEvent event;
     XNextEvent(dpy, &event);
 
     switch (event.type) {
       case Expose:
-        XClearWindow(dpy, win);
-        XSetForeground(dpy, gc, color_input.pixel);
-        XDrawString(dpy, win, gc, TEXTBOX_X, TEXTBOX_Y, inputText.c_str(), static_cast<int>(inputText.size()));
+        redraw();
         break;
 
       case KeyPress: {
+        const auto pressed = std::chrono::steady_clock::now();
         KeySym keysym;
         char buffer[32];
         int bytes = XLookupString(&event.xkey, buffer, sizeof(buffer), &keysym, nullptr);
@@ -114,16 +384,21 @@ int main() {
           running = false;
           break;
         } else if (keysym == XK_Return) {
-          t.insert(inputText);
+          worker.post([&t, &wal, &publisher, word = inputText] {
+            t.insert(word);
+            wal.insert(word);
+            if (publisher.has_value()) {
+              static_cast<void>(publisher->publish(t));
+            }
+            if (wal.needsCompaction()) {
+              static_cast<void>(wal.compact(t));
+            }
+          });
           inputText.clear();
         } else if (keysym == XK_Tab) {
-          auto result = t.autocomplete(inputText, 1);
-          if (!result.empty()) {
-            const auto& completed_str = result.front();
-            inputText = completed_str;
-            XSetForeground(dpy, gc, color_suggestion.pixel);
-            XDrawString(dpy, win, gc, TEXTBOX_X, TEXTBOX_Y, completed_str.c_str(),
-                        static_cast<int>(completed_str.size()));
+          if (suggestion.starts_with(inputText)) {
+            inputText = suggestion;
+            worker.post([&t, word = suggestion] { t.record_use(word); });
           }
         } else if (keysym == XK_space) {
           break;
@@ -132,18 +407,12 @@ int main() {
             inputText.append(buffer, bytes);
           }
         }
-        XClearWindow(dpy, win);
-        auto result = t.autocomplete(inputText, 1);
-        if (!result.empty()) {
-          const auto& completed_str = result.front();
-          XSetForeground(dpy, gc, color_suggestion.pixel);
-          XDrawString(dpy, win, gc, TEXTBOX_X, TEXTBOX_Y, completed_str.c_str(),
-                      static_cast<int>(completed_str.size()));
+        // The typed text is drawn at once; the suggestion follows when the worker has it.
+        redraw();
+        latest = worker.request(inputText);
+        if (measure_latency) {
+          waiting.push_back(pressed);
         }
-
-        XSetForeground(dpy, gc, color_input.pixel);
-        XDrawString(dpy, win, gc, TEXTBOX_X, TEXTBOX_Y, inputText.c_str(), static_cast<int>(inputText.size()));
-
         break;
       }
 
@@ -152,6 +421,16 @@ int main() {
     }
   }
 
+  if (measure_latency && !latencies.empty()) {
+    std::sort(latencies.begin(), latencies.end());
+    const auto percentile = [&](const double p) {
+      return latencies[static_cast<size_t>(p * static_cast<double>(latencies.size() - 1))];
+    };
+    std::cerr << "keypress-to-draw latency over " << latencies.size() << " keys (us): p50 " << percentile(0.5)
+              << ", p90 " << percentile(0.9) << ", p99 " << percentile(0.99) << ", max " << latencies.back()
+              << "; " << worker.dropped() << " stale requests dropped\n";
+  }
+
   if (fontInfo) {
     XFreeFont(dpy, fontInfo);
   }
@@ -174,7 +453,7 @@ int main() {
     }
 
     std::cout << "Suggested words:" << '\n';
-    auto result = t.autocomplete(input, MAX_SUGGESTIONS);
+    auto result = suggest(t, input, MAX_SUGGESTIONS, keystroke());
     while (!result.empty()) {
       std::cout << result.front() << '\n';
       result.pop();
@@ -183,6 +462,5 @@ int main() {
   }
 #endif
 
-  file.close();
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,79 @@
+#include <catch2/catch_all.hpp>
+#include <iostream>
+
+#include "../include/ct9/Trie.h"
+
+static_assert(LowercaseTrie::isValidKey("hello"));
+static_assert(!LowercaseTrie::isValidKey("Hello"));
+static_assert(!LowercaseTrie::isValidKey(""));
+static_assert(DigitTrie::isValidKey("4663"));
+static_assert(!DigitTrie::isValidKey("46a3"));
+static_assert(Trie::isValidKey("Hello"));
+static_assert(LowercaseAlphabet::kSize == 26 && DigitAlphabet::kSize == 10);
+static_assert(LowercaseAlphabet::index('a') == 0 && LowercaseAlphabet::index('z') == 25);
+static_assert(LowercaseAlphabet::symbol(LowercaseAlphabet::index('q')) == 'q');
+
+TEST_CASE("Trie Alphabet Policies") {
+
+  SECTION("Lowercase trie matches the default trie") {
+    const std::vector<std::string> words = {"apple", "app", "application", "apricot", "banana", "band", "bat"};
+    Trie trie(words);
+    LowercaseTrie dense(words);
+
+    REQUIRE(dense.autocomplete("", INT_MAX) == trie.autocomplete("", INT_MAX));
+    REQUIRE(dense.autocomplete("ap", 2) == trie.autocomplete("ap", 2));
+    REQUIRE(dense.size() == trie.size());
+  }
+
+  SECTION("Dense children are indexed directly") {
+    LowercaseTrie trie;
+    trie.insert("cat");
+
+    const auto* root = trie.getRoot();
+    REQUIRE(root->children.size() == 1);
+    REQUIRE(root->children.contains('c'));
+    REQUIRE_FALSE(root->children.contains('d'));
+    REQUIRE(root->children.find('c')->second->children.contains('a'));
+    REQUIRE(root->children.find('d') == root->children.end());
+  }
+
+  SECTION("Characters outside of the alphabet separate words") {
+    LowercaseTrie trie;
+    trie.insert("good Home");
+
+    REQUIRE(trie.contain("good"));
+    REQUIRE(trie.contain("ome"));
+    REQUIRE_FALSE(trie.contain("Home"));
+    REQUIRE(trie.autocomplete("H").empty());
+  }
+
+  SECTION("Digit trie") {
+    DigitTrie trie(std::vector<std::string>{"4663", "466", "123"});
+
+    REQUIRE(trie.contain("466"));
+    REQUIRE(trie.autocomplete("46", INT_MAX) == std::queue<std::string>({"466", "4663"}));
+    REQUIRE(trie.autocomplete("x").empty());
+  }
+
+  SECTION("Deletion and copy on a dense trie") {
+    LowercaseTrie trie(std::vector<std::string>{"car", "cart", "care"});
+    LowercaseTrie copy(trie);
+
+    trie.del("cart");
+    REQUIRE_FALSE(trie.contain("cart"));
+    REQUIRE(trie.contain("car"));
+    REQUIRE(copy.contain("cart"));
+    REQUIRE(trie != copy);
+
+    trie.del("car");
+    trie.del("care");
+    REQUIRE(trie.getRoot()->children.empty());
+  }
+
+  SECTION("Contain does not report bare prefixes") {
+    Trie trie(std::vector<std::string>{"apple"});
+
+    REQUIRE(trie.contain("apple"));
+    REQUIRE_FALSE(trie.contain("app"));
+  }
+}
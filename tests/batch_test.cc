@@ -0,0 +1,70 @@
+#include <catch2/catch_all.hpp>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#include "../include/ct9/BatchQuery.h"
+#include "../include/ct9/Trie.h"
+
+static std::string runBatch(const BatchQuery::Options& options, const std::string& input, const Trie& trie,
+                            BatchQuery::Report& report) {
+  std::FILE* output = std::tmpfile();
+  REQUIRE(output != nullptr);
+  report = BatchQuery(options).run(input, fileno(output),
+                                   [&](const std::string& prefix) { return trie.autocomplete(prefix, 2); });
+  std::string written(static_cast<size_t>(std::ftell(output)), '\0');
+  std::rewind(output);
+  REQUIRE(std::fread(written.data(), 1, written.size(), output) == written.size());
+  std::fclose(output);
+  return written;
+}
+
+TEST_CASE("Batch Queries") {
+  const Trie trie(std::vector<std::string>{"apple", "application", "apricot", "banana", "band", "cat"});
+  BatchQuery::Report report;
+
+  SECTION("Every line gets the query and its answers, tab-separated") {
+    const std::string output = runBatch({1, 1024, 0}, "ap\nban\r\nzzz\n\nc", trie, report);
+    REQUIRE(output == "ap\tapple\tapplication\nban\tbanana\tband\nzzz\n\tapple\tapplication\nc\tcat\n");
+    REQUIRE(report.queries == 5);
+    REQUIRE(report.max >= report.p50);
+  }
+
+  SECTION("Output keeps input order across threads and small chunks") {
+    const std::vector<std::string> prefixes = {"a", "ap", "b", "ban", "c", "x", "app", "apr", ""};
+    std::string input;
+    std::string expected;
+    for (size_t i = 0; i < 2000; ++i) {
+      const std::string& prefix = prefixes[(i * 7) % prefixes.size()];
+      input += prefix + '\n';
+      expected += prefix;
+      std::queue<std::string> words = trie.autocomplete(prefix, 2);
+      while (!words.empty()) {
+        expected += '\t' + words.front();
+        words.pop();
+      }
+      expected += '\n';
+    }
+
+    for (const size_t threads : {1, 3, 8}) {
+      REQUIRE(runBatch({threads, 16, 2}, input, trie, report) == expected);
+      REQUIRE(report.queries == 2000);
+    }
+  }
+
+  SECTION("Empty input") {
+    REQUIRE(runBatch({4, 1024, 0}, "", trie, report).empty());
+    REQUIRE(report.queries == 0);
+  }
+
+  SECTION("Mapped file") {
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "ct9_batch_test.txt";
+    std::ofstream(path) << "ap\nb\n";
+    const MappedFile file(path.string());
+    REQUIRE(file.isOpen());
+    REQUIRE(file.view() == "ap\nb\n");
+    REQUIRE_FALSE(MappedFile((path.parent_path() / "ct9_missing_file").string()).isOpen());
+    std::filesystem::remove(path);
+  }
+}
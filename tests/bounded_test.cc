@@ -0,0 +1,73 @@
+#include <catch2/catch_all.hpp>
+#include <iostream>
+
+#include "../include/ct9/BoundedTrie.h"
+
+TEST_CASE("Trie CLOCK Sweep") {
+  Trie trie(std::vector<std::string>{"apple", "banana", "cherry", "date"});
+  std::string hand;
+
+  SECTION("Unread words are victims, read ones get a second chance") {
+    REQUIRE(trie.contain("banana"));
+    REQUIRE(trie.autocomplete("d", 1).front() == "date");
+    REQUIRE(trie.sweep(hand, 10) == std::vector<std::string>{"apple", "cherry"});
+    REQUIRE(trie.sweep(hand, 10) == std::vector<std::string>{"apple", "banana", "cherry", "date"});
+  }
+
+  SECTION("The hand resumes where it stopped and wraps around") {
+    REQUIRE(trie.sweep(hand, 1) == std::vector<std::string>{"apple"});
+    REQUIRE(hand == "b");
+    REQUIRE(trie.sweep(hand, 2) == std::vector<std::string>{"banana", "cherry"});
+    REQUIRE(trie.sweep(hand, 2) == std::vector<std::string>{"date", "apple"});
+  }
+
+  SECTION("Limit caps the words looked at") {
+    for (const char* word : {"apple", "banana", "cherry", "date"}) {
+      REQUIRE(trie.contain(word));
+    }
+    REQUIRE(trie.sweep(hand, 10, 3).empty());
+    REQUIRE(hand == "d");
+    REQUIRE(trie.sweep(hand, 10) == std::vector<std::string>{"apple", "banana", "cherry"});
+  }
+
+  SECTION("Internal copies do not count as reads") {
+    const Trie copy = trie + Trie();
+    REQUIRE(trie == copy);
+    REQUIRE(trie.sweep(hand, 10).size() == 4);
+  }
+}
+
+TEST_CASE("Bounded Trie") {
+  SECTION("Node accounting matches the trie") {
+    BoundedTrie trie(SIZE_MAX);
+    trie.insert("car cart carbon care cat dog");
+    REQUIRE(trie.bytes() == (trie.words().size() + 1) * BoundedTrie::kNodeBytes);
+    for (const char* word : {"cart", "car", "dog", "missing", "carbon", "cat"}) {
+      trie.del(word);
+      REQUIRE(trie.bytes() == (trie.words().size() + 1) * BoundedTrie::kNodeBytes);
+    }
+    REQUIRE(trie.autocomplete("") == std::queue<std::string>({"care"}));
+  }
+
+  SECTION("Stays within budget and keeps the words that are read") {
+    const size_t budget = 200 * BoundedTrie::kNodeBytes;
+    BoundedTrie trie(budget);
+    const std::vector<std::string> hot = {"alpha", "bravo", "charlie", "delta"};
+    for (const std::string& word : hot) {
+      trie.insert(word);
+    }
+    for (int i = 0; i < 2000; ++i) {
+      std::string cold = "x";
+      for (int n = i; n > 0; n /= 26) {
+        cold.push_back(static_cast<char>('a' + n % 26));
+      }
+      trie.insert(cold);
+      for (const std::string& word : hot) {
+        REQUIRE(trie.contain(word));
+      }
+      REQUIRE(trie.bytes() <= budget);
+      REQUIRE(trie.bytes() == (trie.words().size() + 1) * BoundedTrie::kNodeBytes);
+    }
+    REQUIRE(trie.evicted() > 0);
+  }
+}
@@ -0,0 +1,78 @@
+#include <catch2/catch_all.hpp>
+#include <iostream>
+
+#include "../include/ct9/Trie.h"
+
+static std::queue<std::string> drain(const Trie& trie, const std::string& prefix, const size_t count,
+                                     const Trie::Budget& budget, size_t& calls) {
+  std::queue<std::string> all;
+  std::string cursor;
+  calls = 0;
+  do {
+    std::queue<std::string> page = trie.autocomplete(prefix, count, budget, cursor);
+    ++calls;
+    while (!page.empty()) {
+      all.push(page.front());
+      page.pop();
+    }
+  } while (!cursor.empty());
+  return all;
+}
+
+TEST_CASE("Trie Bounded Autocomplete") {
+  const std::vector<std::string> words = {"app",  "apple", "application", "apricot", "banana",
+                                          "band", "bat",   "cat",         "catalog", "dog"};
+  Trie trie(words);
+
+  SECTION("Unlimited budget equals plain autocomplete") {
+    std::string cursor;
+    REQUIRE(trie.autocomplete("", INT_MAX, {}, cursor) == trie.autocomplete(""));
+    REQUIRE(cursor.empty());
+    REQUIRE(trie.autocomplete("ap", 2, {}, cursor) == trie.autocomplete("ap", 2));
+    REQUIRE(cursor == "appli");
+    REQUIRE(trie.autocomplete("ap", 2, {}, cursor) == std::queue<std::string>({"application", "apricot"}));
+    REQUIRE(cursor.empty());
+  }
+
+  SECTION("Node budget splits the walk into resumable pages") {
+    size_t calls = 0;
+    REQUIRE(drain(trie, "", INT_MAX, {1}, calls) == trie.autocomplete(""));
+    REQUIRE(calls == trie.size() + 1);
+    REQUIRE(drain(trie, "ba", 1, {3}, calls) == trie.autocomplete("ba"));
+    REQUIRE(drain(trie, "zz", 5, {3}, calls).empty());
+    REQUIRE(drain(trie, "", INT_MAX, {0}, calls) == trie.autocomplete(""));
+    REQUIRE(calls == trie.size() + 1);
+  }
+
+  SECTION("Cursor survives changes to the trie") {
+    std::string cursor;
+    REQUIRE(trie.autocomplete("", 3, {}, cursor) == std::queue<std::string>({"app", "apple", "application"}));
+    REQUIRE(cursor == "apr");
+    trie.del("apricot");
+    trie.insert("apz");
+    trie.insert("aa");
+    REQUIRE(trie.autocomplete("", 2, {}, cursor) == std::queue<std::string>({"apz", "banana"}));
+  }
+
+  SECTION("Deadline") {
+    Trie large;
+    for (char first = 'a'; first <= 'z'; ++first) {
+      for (char second = 'a'; second <= 'z'; ++second) {
+        large.insert(std::string{first, second});
+      }
+    }
+    std::string cursor;
+    const Trie::Budget expired{SIZE_MAX, std::chrono::steady_clock::now()};
+    const std::queue<std::string> page = large.autocomplete("", INT_MAX, expired, cursor);
+    REQUIRE(page.size() < 26 * 26);
+    REQUIRE_FALSE(cursor.empty());
+  }
+
+  SECTION("Dense alphabet") {
+    LowercaseTrie dense(words);
+    std::string cursor;
+    REQUIRE(dense.autocomplete("ca", 1, {}, cursor) == std::queue<std::string>({"cat"}));
+    REQUIRE(dense.autocomplete("ca", 1, {}, cursor) == std::queue<std::string>({"catalog"}));
+    REQUIRE(cursor.empty());
+  }
+}
@@ -0,0 +1,52 @@
+#include <catch2/catch_all.hpp>
+#include <iostream>
+
+#include "../include/ct9/Trie.h"
+
+TEST_CASE("Trie Bulk Lookups") {
+  const std::vector<std::string> words = {"app", "apple", "application", "apricot", "banana", "band", "bat"};
+  const std::vector<std::string> queries = {"apple", "ap",  "",     "band", "bandana", "xyz", "bat",
+                                            "app",   "b",   "bat!", "apricot", "applications", "Bat"};
+
+  SECTION("Whole words") {
+    Trie trie(words);
+    const std::vector<bool> found = trie.contain_many(queries);
+    REQUIRE(found.size() == queries.size());
+    for (size_t i = 0; i < queries.size(); ++i) {
+      REQUIRE(found[i] == trie.contain(queries[i]));
+    }
+    REQUIRE(trie.contain_many({}).empty());
+  }
+
+  SECTION("Prefixes") {
+    Trie trie(words);
+    const std::vector<bool> found = trie.prefix_many(queries);
+    const std::vector<bool> expected = {true, true, true, true, false, false, true,
+                                        true, true, false, true, false, false};
+    REQUIRE(found == expected);
+  }
+
+  SECTION("Prefixes of an empty trie, or of erased words, are absent") {
+    const std::vector<std::string> prefixes = {"", "a", "ba"};
+    REQUIRE(Trie().prefix_many(prefixes) == std::vector<bool>{false, false, false});
+    Trie trie(words);
+    REQUIRE(trie.erase_prefix("a") == 4);
+    REQUIRE(trie.prefix_many(prefixes) == std::vector<bool>{true, false, true});
+    trie.del("banana");
+    trie.del("band");
+    trie.del("bat");
+    REQUIRE(trie.prefix_many(prefixes) == std::vector<bool>{false, false, false});
+  }
+
+  SECTION("More keys than lookups in flight") {
+    LowercaseTrie trie(words);
+    std::vector<std::string> many;
+    for (size_t i = 0; i < 100; ++i) {
+      many.push_back(queries[i % queries.size()]);
+    }
+    const std::vector<bool> found = trie.contain_many(many);
+    for (size_t i = 0; i < many.size(); ++i) {
+      REQUIRE(found[i] == trie.contain(many[i]));
+    }
+  }
+}
@@ -0,0 +1,63 @@
+#include <catch2/catch_all.hpp>
+#include <iostream>
+
+#include "../include/ct9/Trie.h"
+
+TEST_CASE("Trie Compaction") {
+  const std::vector<std::string> words = {"apple", "app", "application", "apricot", "banana", "band", "bat"};
+
+  SECTION("Full compaction keeps every word") {
+    Trie trie(words);
+    trie.insert("temporary");
+    trie.del("temporary");
+    const auto expected = trie.autocomplete("");
+    const size_t nodes = trie.size();
+
+    static_cast<void>(trie.compact());
+    REQUIRE(trie.autocomplete("") == expected);
+    REQUIRE(trie.size() == nodes);
+    REQUIRE(trie.contain("app"));
+    REQUIRE_FALSE(trie.contain("ap"));
+
+    trie.insert("apex");
+    trie.del("band");
+    REQUIRE(trie.autocomplete("ap", 2) == std::queue<std::string>({"apex", "app"}));
+    REQUIRE_FALSE(trie.contain("band"));
+  }
+
+  SECTION("Compacting an empty trie") {
+    Trie trie;
+    static_cast<void>(trie.compact());
+    REQUIRE(trie.size() == 0);
+    REQUIRE(trie.getRoot()->children.empty());
+  }
+
+  SECTION("Incremental compaction in bounded steps") {
+    Trie trie(words);
+    const auto expected = trie.autocomplete("");
+    const auto* old_root = trie.getRoot();
+
+    size_t steps = 1;
+    while (!trie.compactStep(3)) {
+      ++steps;
+    }
+    REQUIRE(steps == (2 * (trie.size() + 1) + 2) / 3);
+    REQUIRE(trie.getRoot() != old_root);
+    REQUIRE(trie.autocomplete("") == expected);
+    Trie::releaseFreeMemory();
+    REQUIRE(trie.autocomplete("") == expected);
+  }
+
+  SECTION("Mutations between incremental steps") {
+    LowercaseTrie trie(words);
+    REQUIRE_FALSE(trie.compactStep(2));
+    trie.del("apricot");
+    trie.insert("cherry");
+    REQUIRE_FALSE(trie.compactStep(4));
+    trie.del("banana");
+    while (!trie.compactStep(4)) {
+    }
+    REQUIRE(trie.autocomplete("") ==
+            std::queue<std::string>({"app", "apple", "application", "band", "bat", "cherry"}));
+  }
+}
@@ -0,0 +1,48 @@
+#include <catch2/catch_all.hpp>
+#include <iostream>
+
+#include "../include/ct9/Trie.h"
+
+TEST_CASE("Trie Bulk Erase") {
+  const std::vector<std::string> words = {"app", "apple", "application", "apricot", "banana", "band", "bat", "b"};
+
+  SECTION("Erase a prefix subtree") {
+    Trie trie(words);
+    REQUIRE(trie.erase_prefix("app") == 3);
+    REQUIRE(trie.autocomplete("") == std::queue<std::string>({"apricot", "b", "banana", "band", "bat"}));
+    REQUIRE(trie.erase_prefix("xyz") == 0);
+    REQUIRE(trie.erase_prefix("apricot") == 1);
+    REQUIRE(trie.getRoot()->children.size() == 1);
+    REQUIRE(trie.erase_prefix("ban") == 2);
+    REQUIRE(trie.autocomplete("") == std::queue<std::string>({"b", "bat"}));
+  }
+
+  SECTION("Erase everything") {
+    Trie trie(words);
+    trie.insert("");
+    REQUIRE(trie.erase_prefix("") == words.size() + 1);
+    REQUIRE(trie.size() == 0);
+    REQUIRE(trie.autocomplete("").empty());
+    trie.insert("again");
+    REQUIRE(trie.contain("again"));
+  }
+
+  SECTION("Erase a sorted batch") {
+    Trie trie(words);
+    const std::vector<std::string> batch = {"app", "application", "apricots", "b", "band", "zebra"};
+    REQUIRE(trie.erase_many(batch) == 4);
+    REQUIRE(trie.autocomplete("") == std::queue<std::string>({"apple", "apricot", "banana", "bat"}));
+
+    Trie reference(std::vector<std::string>{"apple", "apricot", "banana", "bat"});
+    REQUIRE(trie.size() == reference.size());
+  }
+
+  SECTION("Unsorted batches and duplicates") {
+    LowercaseTrie trie(words);
+    const std::vector<std::string> batch = {"bat", "apple", "bat", "app", "ap", "banana", ""};
+    REQUIRE(trie.erase_many(batch) == 4);
+    REQUIRE(trie.autocomplete("") == std::queue<std::string>({"application", "apricot", "b", "band"}));
+    LowercaseTrie reference(std::vector<std::string>{"application", "apricot", "b", "band"});
+    REQUIRE(trie.size() == reference.size());
+  }
+}
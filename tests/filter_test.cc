@@ -0,0 +1,74 @@
+#include <catch2/catch_all.hpp>
+#include <iostream>
+
+#include "../include/ct9/FilteredTrie.h"
+
+TEST_CASE("Blocked Bloom Filter") {
+  BlockedBloomFilter filter(10000);
+  for (int i = 0; i < 10000; ++i) {
+    filter.insert("key" + std::to_string(i));
+  }
+
+  SECTION("No false negatives") {
+    for (int i = 0; i < 10000; ++i) {
+      REQUIRE(filter.mayContain("key" + std::to_string(i)));
+    }
+  }
+
+  SECTION("Few false positives") {
+    int positives = 0;
+    for (int i = 0; i < 10000; ++i) {
+      positives += filter.mayContain("other" + std::to_string(i));
+    }
+    REQUIRE(positives < 300);
+    filter.clear();
+    REQUIRE_FALSE(filter.mayContain("key1"));
+  }
+}
+
+TEST_CASE("Filtered Trie") {
+  const std::vector<std::string> words = {"app", "apple", "application", "banana", "band"};
+
+  SECTION("Same answers as a plain trie") {
+    FilteredTrie filtered(words);
+    REQUIRE(filtered.contain("apple"));
+    REQUIRE_FALSE(filtered.contain("ap"));
+    REQUIRE_FALSE(filtered.contain("cherry"));
+    REQUIRE(filtered.autocomplete("ban") == std::queue<std::string>({"banana", "band"}));
+
+    filtered.insert("cherry pie");
+    REQUIRE(filtered.contain("cherry"));
+    REQUIRE(filtered.contain("pie"));
+    REQUIRE_FALSE(filtered.contain("cherry pie"));
+  }
+
+  SECTION("Deleted words are gone, also across rebuilds") {
+    FilteredTrie filtered(words);
+    filtered.del("apple");
+    filtered.del("missing");
+    REQUIRE_FALSE(filtered.contain("apple"));
+    filtered.del("band");
+    filtered.del("banana");
+    REQUIRE(filtered.autocomplete("") == std::queue<std::string>({"app", "application"}));
+    filtered.insert("apple");
+    REQUIRE(filtered.contain("apple"));
+  }
+
+  SECTION("Filter grows with the trie") {
+    LowercaseTrie reference;
+    BasicFilteredTrie<LowercaseAlphabet> filtered;
+    const size_t initial = filtered.filter().capacity();
+    for (int i = 0; i < 5000; ++i) {
+      std::string word;
+      for (int n = i; n > 0; n /= 26) {
+        word.push_back(static_cast<char>('a' + n % 26));
+      }
+      filtered.insert(word);
+      filtered.insert(word);
+      reference.insert(word);
+    }
+    REQUIRE(filtered.filter().capacity() > initial);
+    REQUIRE(filtered.autocomplete("") == reference.autocomplete(""));
+    REQUIRE(filtered.contain("ab"));
+  }
+}
@@ -0,0 +1,95 @@
+#include <catch2/catch_all.hpp>
+#include <iostream>
+
+#include "../include/ct9/FoldedTrie.h"
+
+static std::vector<std::string> drain(std::queue<std::string> words) {
+  std::vector<std::string> result;
+  while (!words.empty()) {
+    result.push_back(std::move(words.front()));
+    words.pop();
+  }
+  return result;
+}
+
+TEST_CASE("Trie Surface Forms") {
+  Trie trie(std::vector<std::string>{"apple", "banana"});
+
+  SECTION("Keys without forms are returned as they are") {
+    REQUIRE(drain(trie.autocomplete_forms("")) == std::vector<std::string>{"apple", "banana"});
+    trie.insert_form("apple", "apple");
+    REQUIRE(trie.findNode("apple")->forms == nullptr);
+  }
+
+  SECTION("Forms share the path of their key") {
+    const size_t nodes = trie.size();
+    trie.insert_form("apple", "Apple");
+    trie.insert_form("apple", "APPLE");
+    trie.insert_form("apple", "Apple");
+    trie.insert_form("cherry", "Cherry");
+    REQUIRE(trie.size() == nodes + 6);
+    REQUIRE(drain(trie.autocomplete_forms("")) ==
+            std::vector<std::string>{"apple", "Apple", "APPLE", "banana", "Cherry"});
+    REQUIRE(drain(trie.autocomplete_forms("", 2)) == std::vector<std::string>{"apple", "Apple"});
+    REQUIRE(drain(trie.autocomplete_forms("ch")) == std::vector<std::string>{"Cherry"});
+    REQUIRE(drain(trie.autocomplete("")) == std::vector<std::string>{"apple", "banana", "cherry"});
+  }
+
+  SECTION("The key goes with its last form") {
+    trie.insert_form("apple", "Apple");
+    REQUIRE_FALSE(trie.erase_form("apple", "APPLE"));
+    REQUIRE(trie.erase_form("apple", "apple"));
+    REQUIRE(drain(trie.autocomplete_forms("a")) == std::vector<std::string>{"Apple"});
+    REQUIRE(trie.erase_form("apple", "Apple"));
+    REQUIRE_FALSE(trie.contain("apple"));
+    REQUIRE(trie.erase_form("banana", "banana"));
+    REQUIRE(trie.autocomplete_forms("").empty());
+  }
+
+  SECTION("Forms survive copies and compaction, and go with deleted words") {
+    trie.insert_form("apple", "Apple");
+    const Trie copy(trie);
+    static_cast<void>(trie.compact());
+    REQUIRE(drain(trie.autocomplete_forms("a")) == std::vector<std::string>{"apple", "Apple"});
+    REQUIRE(drain(copy.autocomplete_forms("a")) == std::vector<std::string>{"apple", "Apple"});
+    trie.del("apple");
+    trie.insert("apple");
+    REQUIRE(drain(trie.autocomplete_forms("a")) == std::vector<std::string>{"apple"});
+  }
+}
+
+TEST_CASE("Folded Trie") {
+  SECTION("Keys ignore case and accents") {
+    REQUIRE(FoldedTrie::fold("Café") == "cafe");
+    REQUIRE(FoldedTrie::fold("Straße") == "strasse");
+    REQUIRE(FoldedTrie::fold("ÆSIR Œuvre ĲSSEL") == "aesir oeuvre ijssel");
+    REQUIRE(FoldedTrie::fold("Łódź, Dvořák") == "lodz, dvorak");
+    REQUIRE(FoldedTrie::fold("a×b") == "a×b");
+  }
+
+  SECTION("Every spelling is suggested from one path") {
+    FoldedTrie trie(std::vector<std::string>{"Apple", "apple", "APPLE", "application", "Café", "cafe", "Cafeteria"});
+    REQUIRE(trie.words().size() == Trie(std::vector<std::string>{"apple", "application", "cafeteria"}).size());
+    REQUIRE(drain(trie.autocomplete("APP")) == std::vector<std::string>{"Apple", "apple", "APPLE", "application"});
+    REQUIRE(drain(trie.autocomplete("café")) == std::vector<std::string>{"Café", "cafe", "Cafeteria"});
+    REQUIRE(drain(trie.autocomplete("caf\xC3")) == std::vector<std::string>{"Café", "cafe", "Cafeteria"});
+    REQUIRE(trie.contain("CAFE"));
+    REQUIRE_FALSE(trie.contain("caf"));
+  }
+
+  SECTION("Texts are split at characters that are not letters") {
+    FoldedTrie trie;
+    trie.insert("Crème brûlée, naïve; Zürich");
+    REQUIRE(drain(trie.autocomplete("")) == std::vector<std::string>{"brûlée", "Crème", "naïve", "Zürich"});
+    REQUIRE(trie.contain("zurich"));
+  }
+
+  SECTION("Deleting one spelling keeps the others") {
+    FoldedTrie trie(std::vector<std::string>{"Résumé", "resume"});
+    REQUIRE_FALSE(trie.del("RESUME"));
+    REQUIRE(trie.del("Résumé"));
+    REQUIRE(drain(trie.autocomplete("res")) == std::vector<std::string>{"resume"});
+    REQUIRE(trie.del("resume"));
+    REQUIRE_FALSE(trie.contain("resume"));
+  }
+}
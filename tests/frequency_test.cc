@@ -0,0 +1,158 @@
+#include <catch2/catch_all.hpp>
+#include <iostream>
+#include <thread>
+
+#include "../include/ct9/Trie.h"
+
+static std::vector<std::string> drain(std::queue<std::string> words) {
+  std::vector<std::string> result;
+  while (!words.empty()) {
+    result.push_back(std::move(words.front()));
+    words.pop();
+  }
+  return result;
+}
+
+TEST_CASE("Trie Frequency Learning") {
+  Trie trie(std::vector<std::string>{"car", "card", "care", "cart", "dog"});
+  trie.set_half_life(std::chrono::hours(1));
+  const auto now = std::chrono::steady_clock::now();
+
+  SECTION("Nothing is ranked before the first use") {
+    REQUIRE(trie.frequent("").empty());
+    REQUIRE(trie.usage("car", now) == 0);
+  }
+
+  SECTION("More used words come first, ties in lexicographical order") {
+    for (int i = 0; i < 3; ++i) {
+      trie.record_use("cart", now);
+    }
+    trie.record_use("care", now);
+    trie.record_use("card", now);
+    trie.record_use("dog", now);
+    REQUIRE(drain(trie.frequent("")) == std::vector<std::string>{"cart", "card", "care", "dog"});
+    REQUIRE(drain(trie.frequent("car", 2)) == std::vector<std::string>{"cart", "card"});
+    REQUIRE(drain(trie.frequent("d")) == std::vector<std::string>{"dog"});
+    REQUIRE(trie.frequent("x").empty());
+  }
+
+  SECTION("A word ranks above the longer words it prefixes on a tie") {
+    trie.record_use("card", now);
+    trie.record_use("car", now);
+    REQUIRE(drain(trie.frequent("car")) == std::vector<std::string>{"car", "card"});
+  }
+
+  SECTION("Unknown words and prefixes are ignored") {
+    trie.record_use("ca", now);
+    trie.record_use("zebra", now);
+    REQUIRE(trie.frequent("").empty());
+  }
+
+  SECTION("Usage halves every half-life") {
+    trie.record_use("dog", now);
+    REQUIRE(trie.usage("dog", now) == Catch::Approx(1.0));
+    REQUIRE(trie.usage("dog", now + std::chrono::hours(1)) == Catch::Approx(0.5));
+    REQUIRE(trie.usage("dog", now + std::chrono::hours(3)) == Catch::Approx(0.125));
+  }
+
+  SECTION("Recent uses outweigh older ones") {
+    for (int i = 0; i < 4; ++i) {
+      trie.record_use("cart", now);
+    }
+    trie.record_use("card", now + std::chrono::hours(3));
+    REQUIRE(drain(trie.frequent("car")) == std::vector<std::string>{"card", "cart"});
+  }
+
+  SECTION("Repeated uses keep adding up") {
+    for (int i = 0; i < 1000; ++i) {
+      trie.record_use("dog", now);
+    }
+    REQUIRE(trie.usage("dog", now) == Catch::Approx(1000).epsilon(0.2));
+  }
+
+  SECTION("Ranking survives the rebase of the scale") {
+    trie.record_use("cart", now);
+    trie.record_use("cart", now);
+    trie.record_use("card", now + std::chrono::minutes(10));
+    const auto later = now + std::chrono::hours(17);
+    trie.record_use("dog", later);
+    REQUIRE(trie.usage("dog", later) == Catch::Approx(1.0));
+    REQUIRE(drain(trie.frequent("")) == std::vector<std::string>{"dog"});
+
+    trie.record_use("care", later + std::chrono::hours(100));
+    REQUIRE(drain(trie.frequent("")) == std::vector<std::string>{"care"});
+  }
+
+  SECTION("Deleted words are no longer suggested") {
+    trie.record_use("card", now);
+    trie.record_use("cart", now);
+    trie.record_use("cart", now);
+    trie.del("cart");
+    REQUIRE(drain(trie.frequent("")) == std::vector<std::string>{"card"});
+    trie.insert("cart");
+    REQUIRE(trie.usage("cart", now) == 0);
+  }
+
+  SECTION("Words erased together or by prefix start again from zero") {
+    trie.insert("ca");
+    for (int i = 0; i < 50; ++i) {
+      trie.record_use("car", now);
+    }
+    trie.record_use("ca", now);
+    REQUIRE(trie.erase_many(std::vector<std::string>{"car", "ca"}) == 2);
+    trie.insert("car");
+    REQUIRE(trie.usage("car", now) == 0);
+    REQUIRE(trie.frequent("").empty());
+
+    Trie empty("");
+    empty.record_use("", now);
+    REQUIRE(empty.erase_prefix("") == 1);
+    empty.insert("");
+    REQUIRE(empty.usage("", now) == 0);
+  }
+
+  SECTION("Copies keep the counters and the half-life") {
+    trie.record_use("care", now);
+    trie.record_use("dog", now);
+    trie.record_use("dog", now);
+    Trie copy(trie);
+    Trie assigned;
+    assigned = trie;
+    for (const Trie* other : {&copy, &assigned}) {
+      REQUIRE(drain(other->frequent("")) == std::vector<std::string>{"dog", "care"});
+      REQUIRE(other->usage("dog", now) == trie.usage("dog", now));
+      REQUIRE(other->usage("care", now + std::chrono::hours(1)) == trie.usage("care", now + std::chrono::hours(1)));
+    }
+  }
+
+  SECTION("Compaction keeps the counters") {
+    trie.record_use("care", now);
+    trie.record_use("dog", now);
+    trie.record_use("dog", now);
+    static_cast<void>(trie.compact());
+    REQUIRE(drain(trie.frequent("")) == std::vector<std::string>{"dog", "care"});
+    while (!trie.compactStep(2)) {
+    }
+    REQUIRE(drain(trie.frequent("")) == std::vector<std::string>{"dog", "care"});
+
+    Trie empty("");
+    empty.record_use("", now);
+    const double usage = empty.usage("", now);
+    static_cast<void>(empty.compact());
+    REQUIRE(usage > 0);
+    REQUIRE(empty.usage("", now) == usage);
+  }
+
+  SECTION("Readers run next to a writer recording uses") {
+    std::thread writer([&] {
+      for (int i = 0; i < 2000; ++i) {
+        trie.record_use(i % 3 == 0 ? "dog" : "cart", now);
+      }
+    });
+    for (int i = 0; i < 2000; ++i) {
+      REQUIRE(trie.frequent("", 2).size() <= 2);
+    }
+    writer.join();
+    REQUIRE(drain(trie.frequent("")) == std::vector<std::string>{"cart", "dog"});
+  }
+}
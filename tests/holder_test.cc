@@ -0,0 +1,72 @@
+#include <catch2/catch_all.hpp>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#include "../include/ct9/TrieHolder.h"
+
+TEST_CASE("Trie Holder Hot Reload") {
+
+  SECTION("Publish swaps the version seen by new readers") {
+    TrieHolder holder(Trie(std::vector<std::string>{"apple"}));
+    REQUIRE(holder.read()->contain("apple"));
+
+    holder.publish(Trie(std::vector<std::string>{"banana"}));
+    REQUIRE(holder.read()->contain("banana"));
+    REQUIRE_FALSE(holder.read()->contain("apple"));
+    REQUIRE(holder.reclaim() == 0);
+  }
+
+  SECTION("Pinned snapshots survive a swap") {
+    TrieHolder holder(Trie(std::vector<std::string>{"apple"}));
+    {
+      const auto pinned = holder.read();
+      holder.publish(Trie(std::vector<std::string>{"banana"}));
+      REQUIRE(pinned->autocomplete("") == std::queue<std::string>({"apple"}));
+      REQUIRE(holder.reclaim() == 1);
+    }
+    REQUIRE(holder.reclaim() == 0);
+  }
+
+  SECTION("Reload builds a new version from a file") {
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "ct9_holder_test.txt";
+    std::ofstream(path) << "cherry\ndate\n";
+
+    TrieHolder holder;
+    REQUIRE(holder.reload(path.string()).get());
+    REQUIRE(holder.read()->autocomplete("") == std::queue<std::string>({"cherry", "date"}));
+    REQUIRE_FALSE(holder.reload((path.string() + ".missing")).get());
+    REQUIRE(holder.read()->contain("date"));
+    std::filesystem::remove(path);
+  }
+
+  SECTION("Readers never observe torn state during swaps") {
+    const Trie even(std::vector<std::string>{"alpha", "beta"});
+    const Trie odd(std::vector<std::string>{"gamma", "delta", "epsilon"});
+    TrieHolder holder(even);
+
+    std::atomic<bool> done{false};
+    std::atomic<size_t> torn{0};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+      readers.emplace_back([&] {
+        while (!done.load()) {
+          const auto snapshot = holder.read();
+          const size_t words = snapshot->autocomplete("").size();
+          if (words != 2 && words != 3) {
+            ++torn;
+          }
+        }
+      });
+    }
+    for (int i = 0; i < 200; ++i) {
+      holder.publish(i % 2 == 0 ? odd : even);
+    }
+    done = true;
+    for (std::thread& reader : readers) {
+      reader.join();
+    }
+    REQUIRE(torn == 0);
+    REQUIRE(holder.reclaim() == 0);
+  }
+}
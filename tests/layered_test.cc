@@ -0,0 +1,60 @@
+#include <catch2/catch_all.hpp>
+#include <iostream>
+
+#include "../include/ct9/LayeredTrie.h"
+
+TEST_CASE("Layered Trie") {
+  const auto base = std::make_shared<const Trie>(std::vector<std::string>{"apple", "app", "banana", "band", "cat"});
+
+  SECTION("Base layer only") {
+    LayeredTrie view(base);
+    REQUIRE(view.layers() == 2);
+    REQUIRE(view.contain("apple"));
+    REQUIRE_FALSE(view.contain("ap"));
+    REQUIRE(view.autocomplete("") == base->autocomplete(""));
+    REQUIRE(view.autocomplete("ba", 1) == std::queue<std::string>({"banana"}));
+  }
+
+  SECTION("Private words merge in lexicographic order") {
+    LayeredTrie view(base);
+    view.insert("apricot");
+    view.insert("bandana");
+    view.insert("app");
+
+    REQUIRE(view.autocomplete("") ==
+            std::queue<std::string>({"app", "apple", "apricot", "banana", "band", "bandana", "cat"}));
+    REQUIRE(view.autocomplete("ap", 2) == std::queue<std::string>({"app", "apple"}));
+    REQUIRE(base->autocomplete("").size() == 5);
+  }
+
+  SECTION("Tombstones hide lower layers") {
+    LayeredTrie view(base);
+    view.del("apple");
+    view.del("cat");
+
+    REQUIRE_FALSE(view.contain("apple"));
+    REQUIRE(view.contain("app"));
+    REQUIRE(view.autocomplete("") == std::queue<std::string>({"app", "banana", "band"}));
+    REQUIRE(base->contain("apple"));
+
+    view.insert("apple");
+    REQUIRE(view.contain("apple"));
+    REQUIRE(view.autocomplete("a") == std::queue<std::string>({"app", "apple"}));
+  }
+
+  SECTION("Shared middle layers") {
+    const auto extra = std::make_shared<const Trie>(std::vector<std::string>{"dog"});
+    const auto hidden = std::make_shared<const Trie>(std::vector<std::string>{"band"});
+
+    LayeredTrie first(base);
+    first.push(extra, hidden);
+    LayeredTrie second(base);
+    second.push(extra, hidden);
+    second.del("dog");
+
+    REQUIRE(first.layers() == 3);
+    REQUIRE(first.autocomplete("") == std::queue<std::string>({"app", "apple", "banana", "cat", "dog"}));
+    REQUIRE(second.autocomplete("") == std::queue<std::string>({"app", "apple", "banana", "cat"}));
+    REQUIRE(first.contain("dog"));
+  }
+}
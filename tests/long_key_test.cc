@@ -0,0 +1,68 @@
+#include <catch2/catch_all.hpp>
+#include <iostream>
+#include <memory>
+
+#include "../include/ct9/LayeredTrie.h"
+
+// Deep enough to overflow the default 8 MB stack with one frame per character.
+static constexpr size_t kLength = 1 << 20;
+
+TEST_CASE("Trie Long Keys") {
+  const std::string key = std::string(kLength - 1, 'a') + 'b';
+
+  SECTION("A single key of a million characters") {
+    Trie trie(key);
+    REQUIRE(trie.size() == kLength);
+    REQUIRE(trie.contain(key));
+    REQUIRE_FALSE(trie.contain(key.substr(0, kLength - 1)));
+
+    std::queue<std::string> words = trie.autocomplete("aaa");
+    REQUIRE(words.size() == 1);
+    REQUIRE(words.front() == key);
+    REQUIRE(trie.match("*b").size() == 1);
+    REQUIRE(trie.match("a*a").empty());
+
+    trie.insert(key.substr(0, 10));
+    REQUIRE(trie.rank(key) == 1);
+    REQUIRE(trie.select(1) == key);
+
+    const Trie copy(trie);
+    REQUIRE(copy == trie);
+    REQUIRE(copy.digest() == trie.digest());
+    static_cast<void>(trie.compact());
+    REQUIRE(trie.diff(copy).empty());
+
+    trie.del(key);
+    REQUIRE(trie.size() == 10);
+    REQUIRE(trie.diff(copy).inserts == std::vector<std::string>{key});
+  }
+
+  SECTION("A text of many words is inserted without nesting a call per word") {
+    std::string text;
+    size_t count = 0;
+    for (; text.size() < kLength; ++count) {
+      size_t value = count;
+      do {
+        text.push_back(static_cast<char>('a' + value % 26));
+        value /= 26;
+      } while (value > 0);
+      text.push_back(' ');
+    }
+    text.pop_back();
+    const Trie trie(text);
+    REQUIRE(trie.autocomplete("").size() == count);
+    REQUIRE(trie.contain("ab"));
+  }
+
+  SECTION("Layers walked in lockstep along a long key") {
+    LayeredTrie layered(std::make_shared<const Trie>(key));
+    layered.insert(key + "c");
+    layered.insert(key.substr(0, kLength / 2));
+    layered.del(key);
+    std::queue<std::string> words = layered.autocomplete("");
+    REQUIRE(words.size() == 2);
+    REQUIRE(words.front() == key.substr(0, kLength / 2));
+    words.pop();
+    REQUIRE(words.front() == key + "c");
+  }
+}
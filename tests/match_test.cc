@@ -0,0 +1,58 @@
+#include <catch2/catch_all.hpp>
+#include <iostream>
+
+#include "../include/ct9/Trie.h"
+
+TEST_CASE("Trie Pattern Matching") {
+  Trie trie(std::vector<std::string>{"app", "apple", "application", "apricot", "cat", "cut", "cot", "coat", "dog"});
+
+  SECTION("Single character wildcards") {
+    REQUIRE(trie.match("c?t") == std::queue<std::string>({"cat", "cot", "cut"}));
+    REQUIRE(trie.match("c_t") == std::queue<std::string>({"cat", "cot", "cut"}));
+    REQUIRE(trie.match("???") == std::queue<std::string>({"app", "cat", "cot", "cut", "dog"}));
+  }
+
+  SECTION("Multi character wildcards") {
+    REQUIRE(trie.match("a?p*") == std::queue<std::string>({"app", "apple", "application"}));
+    REQUIRE(trie.match("*t") == std::queue<std::string>({"apricot", "cat", "coat", "cot", "cut"}));
+    REQUIRE(trie.match("*") == trie.autocomplete(""));
+    REQUIRE(trie.match("a**n") == std::queue<std::string>({"application"}));
+    REQUIRE(trie.match("*p*c*") == std::queue<std::string>({"application", "apricot"}));
+  }
+
+  SECTION("Character classes") {
+    REQUIRE(trie.match("c[ao]t") == std::queue<std::string>({"cat", "cot"}));
+    REQUIRE(trie.match("c[!ao]t") == std::queue<std::string>({"cut"}));
+    REQUIRE(trie.match("[a-c]*t") == std::queue<std::string>({"apricot", "cat", "coat", "cot", "cut"}));
+    REQUIRE(trie.match("[^a-c]*") == std::queue<std::string>({"dog"}));
+  }
+
+  SECTION("Literals, limits and misses") {
+    REQUIRE(trie.match("apple") == std::queue<std::string>({"apple"}));
+    REQUIRE(trie.match("appl").empty());
+    REQUIRE(trie.match("c?t", 2) == std::queue<std::string>({"cat", "cot"}));
+    REQUIRE(trie.match("*", 0).empty());
+    REQUIRE(trie.match("x*").empty());
+    REQUIRE(trie.match("c[at").empty());
+  }
+
+  SECTION("Agrees with brute-force enumeration") {
+    for (const std::string pattern : {"*o*", "?o?", "a*e", "*[lt]", "c*t*", "[a-z][a-z]*"}) {
+      WildcardPattern automaton(pattern);
+      std::queue<std::string> all = trie.autocomplete("", INT_MAX);
+      std::queue<std::string> expected;
+      while (!all.empty()) {
+        if (automaton.matches(all.front())) {
+          expected.push(all.front());
+        }
+        all.pop();
+      }
+      REQUIRE(trie.match(pattern) == expected);
+    }
+  }
+
+  SECTION("Dense alphabet") {
+    LowercaseTrie dense(std::vector<std::string>{"cat", "cot", "cut"});
+    REQUIRE(dense.match("c[ou]?") == std::queue<std::string>({"cot", "cut"}));
+  }
+}
@@ -0,0 +1,68 @@
+#include <catch2/catch_all.hpp>
+#include <iostream>
+
+#include "../include/ct9/Trie.h"
+
+template <typename TrieType>
+static void requireConsistent(const TrieType& trie) {
+  std::queue<std::string> all = trie.autocomplete("");
+  size_t position = 0;
+  while (!all.empty()) {
+    REQUIRE(trie.rank(all.front()) == position);
+    REQUIRE(trie.select(position) == all.front());
+    all.pop();
+    ++position;
+  }
+  REQUIRE_FALSE(trie.select(position).has_value());
+}
+
+TEST_CASE("Trie Rank, Select and Range") {
+  const std::vector<std::string> words = {"app", "apple", "application", "apricot", "banana", "band", "bat", "cat"};
+  Trie trie(words);
+
+  SECTION("Rank and select agree with the sorted word list") {
+    requireConsistent(trie);
+    REQUIRE(trie.rank("") == 0);
+    REQUIRE(trie.rank("a") == 0);
+    REQUIRE(trie.rank("appz") == 3);
+    REQUIRE(trie.rank("b") == 4);
+    REQUIRE(trie.rank("zzz") == 8);
+    REQUIRE(trie.select(6) == "bat");
+  }
+
+  SECTION("Range queries") {
+    REQUIRE(trie.range("apple", "b") == std::queue<std::string>({"apple", "application", "apricot"}));
+    REQUIRE(trie.range("applz", "bat") == std::queue<std::string>({"apricot", "banana", "band"}));
+    REQUIRE(trie.range("", "zz", 2) == std::queue<std::string>({"app", "apple"}));
+    REQUIRE(trie.range("band", "band").empty());
+    REQUIRE(trie.range("c", "a").empty());
+  }
+
+  SECTION("Counts follow every kind of update") {
+    trie.insert("apple");
+    trie.insert("dog cow");
+    trie.insert("");
+    requireConsistent(trie);
+    trie.del("apple");
+    trie.del("missing");
+    requireConsistent(trie);
+    REQUIRE(trie.erase_prefix("ban") == 2);
+    requireConsistent(trie);
+    REQUIRE(trie.erase_many(std::vector<std::string>{"app", "cow"}) == 2);
+    requireConsistent(trie);
+    static_cast<void>(trie.compact());
+    requireConsistent(trie);
+    while (!trie.compactStep(2)) {
+    }
+    requireConsistent(trie);
+    const Trie copy = trie;
+    requireConsistent(copy);
+    REQUIRE(copy.select(0) == "");
+  }
+
+  SECTION("Dense alphabet") {
+    LowercaseTrie dense(words);
+    requireConsistent(dense);
+    REQUIRE(dense.range("b", "c") == std::queue<std::string>({"banana", "band", "bat"}));
+  }
+}
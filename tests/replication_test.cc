@@ -0,0 +1,269 @@
+#include <unistd.h>
+
+#include <catch2/catch_all.hpp>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <set>
+
+#include "../include/ct9/Replication.h"
+
+static std::set<std::string> wordsOf(const Trie& trie) {
+  std::set<std::string> words;
+  for (std::queue<std::string> all = trie.autocomplete(""); !all.empty(); all.pop()) {
+    words.insert(all.front());
+  }
+  return words;
+}
+
+TEST_CASE("Trie Digest") {
+  Trie trie(std::vector<std::string>{"car", "card", "dog"});
+  const std::uint64_t initial = trie.digest();
+
+  SECTION("Equal words give equal digests, whatever the insertion order") {
+    REQUIRE(Trie(std::vector<std::string>{"dog", "card", "car"}).digest() == initial);
+    REQUIRE(Trie().digest() == Trie().digest());
+    REQUIRE(Trie().digest() != initial);
+  }
+
+  SECTION("Every kind of change is seen, and undoing it restores the digest") {
+    trie.insert("cart");
+    REQUIRE(trie.digest() != initial);
+    trie.del("cart");
+    REQUIRE(trie.digest() == initial);
+
+    trie.del("car");
+    REQUIRE(trie.digest() != initial);
+    trie.insert("car");
+    REQUIRE(trie.digest() == initial);
+
+    REQUIRE(trie.erase_prefix("ca") == 2);
+    REQUIRE(trie.digest() == Trie("dog").digest());
+    const std::vector<std::string> all{"dog"};
+    REQUIRE(trie.erase_many(all) == 1);
+    REQUIRE(trie.digest() == Trie().digest());
+  }
+
+  SECTION("Re-inserting a stored word changes nothing") {
+    trie.insert("card");
+    REQUIRE(trie.digest() == initial);
+  }
+
+  SECTION("Copies and compaction keep the digest") {
+    const Trie copy(trie);
+    REQUIRE(copy.digest() == initial);
+    static_cast<void>(trie.compact());
+    REQUIRE(trie.digest() == initial);
+    while (!trie.compactStep(1)) {
+    }
+    REQUIRE(trie.digest() == initial);
+  }
+}
+
+TEST_CASE("Trie Diff") {
+  SECTION("Inserts and deletes in lexicographical order") {
+    const Trie before(std::vector<std::string>{"apple", "apply", "banana", "cat"});
+    const Trie after(std::vector<std::string>{"app", "apple", "band", "cat", "catalog"});
+    const Trie::Delta delta = before.diff(after);
+    REQUIRE(delta.inserts == std::vector<std::string>{"app", "band", "catalog"});
+    REQUIRE(delta.deletes == std::vector<std::string>{"apply", "banana"});
+    REQUIRE(after.diff(before).inserts == delta.deletes);
+    REQUIRE(before.diff(before).empty());
+  }
+
+  SECTION("Applying the delta gives the other trie") {
+    std::mt19937 generator(5);
+    std::uniform_int_distribution<int> letter('a', 'e');
+    std::uniform_int_distribution<size_t> length(1, 6);
+    for (int round = 0; round < 50; ++round) {
+      Trie mine;
+      Trie theirs;
+      for (int i = 0; i < 60; ++i) {
+        std::string word(length(generator), ' ');
+        for (char& character : word) {
+          character = static_cast<char>(letter(generator));
+        }
+        if (i % 3 != 0) {
+          mine.insert(word);
+        }
+        if (i % 3 != 1) {
+          theirs.insert(word);
+        }
+      }
+      Trie patched(mine);
+      patched.apply(mine.diff(theirs));
+      REQUIRE(wordsOf(patched) == wordsOf(theirs));
+      REQUIRE(patched.digest() == theirs.digest());
+    }
+  }
+}
+
+TEST_CASE("Trie Replication") {
+  SECTION("Frames survive encoding") {
+    DeltaFrame frame;
+    frame.base = 1;
+    frame.target = UINT64_MAX;
+    frame.delta.inserts = {"app", "apple", "application", std::string(300, 'z')};
+    frame.delta.deletes = {"x"};
+    const std::string bytes = frame.encode();
+
+    size_t used = 0;
+    REQUIRE_FALSE(DeltaFrame::decode(std::string_view(bytes).substr(0, bytes.size() - 1), used).has_value());
+    REQUIRE(used == 0);
+    const std::optional<DeltaFrame> decoded = DeltaFrame::decode(bytes, used);
+    REQUIRE(used == bytes.size());
+    REQUIRE(decoded.has_value());
+    REQUIRE(decoded->base == 1);
+    REQUIRE(decoded->target == UINT64_MAX);
+    REQUIRE(decoded->delta.inserts == frame.delta.inserts);
+    REQUIRE(decoded->delta.deletes == frame.delta.deletes);
+
+    std::string damaged = bytes;
+    damaged[10] ^= 1;
+    REQUIRE_FALSE(DeltaFrame::decode(damaged, used).has_value());
+    REQUIRE(used == bytes.size());
+  }
+
+  SECTION("A damaged length field does not hold back the frames behind it") {
+    DeltaFrame frame;
+    frame.delta.inserts = {"kept"};
+    const std::string bytes = frame.encode();
+    std::string stream = bytes;
+    stream[4] = '\xFF';
+    stream += bytes;
+
+    size_t used = 0;
+    REQUIRE_FALSE(DeltaFrame::decode(stream, used).has_value());
+    REQUIRE(used == 1);
+    std::optional<DeltaFrame> decoded;
+    for (size_t offset = 0; !decoded.has_value() && offset < stream.size(); offset += used) {
+      decoded = DeltaFrame::decode(std::string_view(stream).substr(offset), used);
+      REQUIRE(used > 0);
+    }
+    REQUIRE(decoded.has_value());
+    REQUIRE(decoded->delta.inserts == frame.delta.inserts);
+  }
+
+  SECTION("A follower on a pipe keeps up with the leader") {
+    int pipe_fds[2];
+    REQUIRE(::pipe(pipe_fds) == 0);
+    Trie live(std::vector<std::string>{"alpha", "beta", "gamma"});
+    ReplicaPublisher publisher(pipe_fds[1]);
+    ReplicaFollower follower(pipe_fds[0]);
+
+    REQUIRE(follower.pump() == 0);
+    REQUIRE(publisher.publish(live) > 0);
+    REQUIRE(publisher.publish(live) == 0);
+    REQUIRE(follower.pump() == 1);
+    REQUIRE(follower.words() == live);
+
+    live.insert("delta");
+    live.del("beta");
+    REQUIRE(publisher.publish(live) > 0);
+    live.insert("epsilon");
+    REQUIRE(publisher.publish(live) > 0);
+    REQUIRE(follower.pump() == 2);
+    REQUIRE(follower.inSync());
+    REQUIRE(wordsOf(follower.words()) == std::set<std::string>{"alpha", "delta", "epsilon", "gamma"});
+
+    ::close(pipe_fds[0]);
+    ::close(pipe_fds[1]);
+  }
+
+  SECTION("A frame that did not fit in the pipe is sent again") {
+    int pipe_fds[2];
+    REQUIRE(::pipe(pipe_fds) == 0);
+    ::fcntl(pipe_fds[1], F_SETFL, ::fcntl(pipe_fds[1], F_GETFL) | O_NONBLOCK);
+    const auto fill = [&] {
+      const std::string junk(4096, 'x');
+      while (::write(pipe_fds[1], junk.data(), junk.size()) > 0) {
+      }
+      while (::write(pipe_fds[1], junk.data(), 1) > 0) {
+      }
+    };
+    Trie live(std::vector<std::string>{"alpha", "beta"});
+    ReplicaPublisher publisher(pipe_fds[1]);
+    ReplicaFollower follower(pipe_fds[0]);
+
+    fill();
+    REQUIRE(publisher.publish(live) == 0);
+    REQUIRE(publisher.shipped().autocomplete("").empty());
+    REQUIRE(follower.pump() == 0);
+    REQUIRE(publisher.publish(live) > 0);
+    REQUIRE(follower.pump() == 1);
+    REQUIRE(follower.inSync());
+    REQUIRE(follower.words() == live);
+
+    // Only the start of the next frame fits; the rest goes out before anything else.
+    fill();
+    char room[4096];
+    REQUIRE(::read(pipe_fds[0], room, sizeof(room)) == sizeof(room));
+    for (char first = 'a'; first <= 'z'; ++first) {
+      for (char second = 'a'; second <= 'z'; ++second) {
+        for (char third = 'a'; third <= 'z'; third += 5) {
+          live.insert(std::string("word") + first + second + third);
+        }
+      }
+    }
+    REQUIRE(publisher.publish(live) > 0);
+    REQUIRE(follower.pump() == 0);
+    live.insert("gamma");
+    size_t applied = 0;
+    for (int round = 0; round < 100 && !(follower.words() == live); ++round) {
+      static_cast<void>(publisher.publish(live));
+      applied += follower.pump();
+      REQUIRE(follower.inSync());
+    }
+    REQUIRE(applied == 2);
+    REQUIRE(follower.words() == live);
+
+    ::close(pipe_fds[0]);
+    ::close(pipe_fds[1]);
+  }
+
+  SECTION("A follower that missed frames notices it") {
+    int pipe_fds[2];
+    REQUIRE(::pipe(pipe_fds) == 0);
+    Trie live("one");
+    ReplicaPublisher publisher(pipe_fds[1]);
+    REQUIRE(publisher.publish(live) > 0);
+    char skipped[4096];
+    REQUIRE(::read(pipe_fds[0], skipped, sizeof(skipped)) > 0);
+
+    ReplicaFollower follower(pipe_fds[0]);
+    live.insert("two");
+    REQUIRE(publisher.publish(live) > 0);
+    REQUIRE(follower.pump() == 0);
+    REQUIRE_FALSE(follower.inSync());
+    REQUIRE(follower.words().autocomplete("").empty());
+
+    ::close(pipe_fds[0]);
+    ::close(pipe_fds[1]);
+  }
+
+  SECTION("A follower reading a file catches up from the start and then tails it") {
+    std::FILE* file = std::tmpfile();
+    REQUIRE(file != nullptr);
+    const int fd = ::fileno(file);
+
+    Trie live(std::vector<std::string>{"red", "green"});
+    ReplicaPublisher publisher(fd);
+    REQUIRE(publisher.publish(live) > 0);
+    live.insert("blue");
+    REQUIRE(publisher.publish(live) > 0);
+
+    // The follower opens the file again, so it has its own read offset.
+    const std::string path = "/proc/self/fd/" + std::to_string(fd);
+    const int descriptor = ::open(path.c_str(), O_RDONLY);
+    REQUIRE(descriptor >= 0);
+    ReplicaFollower follower(descriptor);
+    REQUIRE(follower.pump() == 2);
+    live.del("red");
+    REQUIRE(publisher.publish(live) > 0);
+    REQUIRE(follower.pump() == 1);
+    REQUIRE(follower.words() == live);
+
+    ::close(descriptor);
+    std::fclose(file);
+  }
+}
@@ -0,0 +1,72 @@
+#include <catch2/catch_all.hpp>
+#include <iostream>
+
+#include "../include/ct9/AhoCorasick.h"
+
+TEST_CASE("Longest Prefix Match") {
+  const Trie trie(std::vector<std::string>{"he", "her", "hers", "she", "his"});
+
+  REQUIRE(trie.longest_prefix_match("hersheys") == 4);
+  REQUIRE(trie.longest_prefix_match("herb") == 3);
+  REQUIRE(trie.longest_prefix_match("h") == 0);
+  REQUIRE(trie.longest_prefix_match("") == 0);
+  REQUIRE(trie.longest_prefix_match("xhe") == 0);
+}
+
+TEST_CASE("Aho-Corasick Scanner") {
+  const std::vector<std::string> words = {"he", "her", "hers", "she", "his", "is", "s"};
+  const Trie trie(words);
+  const AhoCorasick scanner(trie);
+
+  SECTION("Finds every occurrence, overlapping ones included") {
+    std::vector<std::pair<size_t, size_t>> matches;
+    scanner.scan("ushers", [&](const size_t begin, const size_t length) { matches.emplace_back(begin, length); });
+    const std::vector<std::pair<size_t, size_t>> expected = {{1, 1}, {1, 3}, {2, 2}, {2, 3}, {2, 4}, {5, 1}};
+    std::sort(matches.begin(), matches.end());
+    REQUIRE(matches == expected);
+  }
+
+  SECTION("Agrees with a naive search") {
+    const std::string text = "this_is_his_hershey_she_sells_seashells";
+    size_t naive = 0;
+    for (size_t begin = 0; begin < text.size(); ++begin) {
+      for (size_t length = 1; begin + length <= text.size(); ++length) {
+        naive += trie.contain(text.substr(begin, length)) ? 1 : 0;
+      }
+    }
+    REQUIRE(scanner.count(text) == naive);
+    REQUIRE(scanner.count("") == 0);
+    REQUIRE(scanner.count("xyz") == 0);
+  }
+
+  SECTION("Counting in parallel segments agrees with a single pass") {
+    std::string text;
+    for (size_t i = 0; i < 1000; ++i) {
+      text += words[(i * 7) % words.size()] + (i % 3 == 0 ? "x" : "");
+    }
+    for (const size_t length : {text.size(), text.size() - 5, size_t{40}, size_t{33}}) {
+      const std::string_view part = std::string_view(text).substr(0, length);
+      size_t matches = 0;
+      scanner.scan(part, [&](size_t, size_t) { ++matches; });
+      REQUIRE(scanner.count(part) == matches);
+    }
+  }
+
+  SECTION("Every byte value gets a class of its own") {
+    std::vector<std::string> bytes;
+    std::string text;
+    for (int value = 0; value < 256; ++value) {
+      bytes.emplace_back(1, static_cast<char>(value));
+      text.push_back(static_cast<char>(value));
+    }
+    const AhoCorasick all{BasicTrie<RangeAlphabet<CHAR_MIN, CHAR_MAX>>(bytes)};
+    REQUIRE(all.count(text) == 256);
+    REQUIRE(all.count(text + text) == 512);
+  }
+
+  SECTION("Empty dictionary") {
+    const AhoCorasick empty{Trie()};
+    REQUIRE(empty.states() == 1);
+    REQUIRE(empty.count("anything") == 0);
+  }
+}
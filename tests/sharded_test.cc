@@ -0,0 +1,63 @@
+#include <catch2/catch_all.hpp>
+#include <iostream>
+#include <thread>
+
+#include "../include/ct9/ShardedTrie.h"
+
+TEST_CASE("Sharded Trie") {
+  const std::vector<std::string> words = {"banana", "apple", "Zebra", "app", "band", "cherry", "application"};
+
+  SECTION("Same answers as a single trie") {
+    const ShardedTrie sharded(words);
+    const Trie trie(words);
+    REQUIRE(sharded.autocomplete("") == trie.autocomplete(""));
+    REQUIRE(sharded.autocomplete("", 3) == trie.autocomplete("", 3));
+    REQUIRE(sharded.autocomplete("ban") == std::queue<std::string>({"banana", "band"}));
+    REQUIRE(sharded.autocomplete("x").empty());
+    REQUIRE(sharded.autocomplete("", 0).empty());
+    REQUIRE(sharded.contain("Zebra"));
+    REQUIRE_FALSE(sharded.contain("ap"));
+  }
+
+  SECTION("Text is split into words like Trie::insert") {
+    ShardedTrie sharded;
+    Trie trie;
+    for (const std::string text : {"hello world", "one,two", " lead", "trail "}) {
+      sharded.insert(text);
+      trie.insert(text);
+    }
+    REQUIRE(sharded.autocomplete("") == trie.autocomplete(""));
+    REQUIRE(sharded.contain("") == trie.contain(""));
+  }
+
+  SECTION("Deletion") {
+    ShardedTrie sharded(words);
+    sharded.del("apple");
+    sharded.del("missing");
+    REQUIRE_FALSE(sharded.contain("apple"));
+    REQUIRE(sharded.autocomplete("app") == std::queue<std::string>({"app", "application"}));
+  }
+
+  SECTION("Concurrent writers") {
+    ShardedTrie sharded;
+    std::vector<std::thread> writers;
+    for (int thread = 0; thread < 4; ++thread) {
+      writers.emplace_back([&, thread] {
+        for (int i = 0; i < 200; ++i) {
+          std::string word(1, static_cast<char>('a' + (i + thread) % 26));
+          for (int n = thread * 1000 + i; n > 0; n /= 26) {
+            word.push_back(static_cast<char>('a' + n % 26));
+          }
+          sharded.insert(word);
+          if (i % 2 == 1) {
+            sharded.del(word);
+          }
+        }
+      });
+    }
+    for (std::thread& writer : writers) {
+      writer.join();
+    }
+    REQUIRE(sharded.autocomplete("").size() == 400);
+  }
+}
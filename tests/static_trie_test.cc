@@ -0,0 +1,61 @@
+#include <catch2/catch_all.hpp>
+#include <iostream>
+
+#include "../include/ct9/StaticTrie.h"
+
+// "ab", "abc", "b" laid out breadth-first as ct9_dictgen would emit them.
+static constexpr StaticTrie::Node kTinyNodes[] = {
+    {1u, 2u, 0, false}, {3u, 1u, 97, false}, {4u, 0u, 98, true}, {4u, 1u, 98, true}, {5u, 0u, 99, true},
+};
+static constexpr StaticTrie kTiny{kTinyNodes};
+
+static_assert(kTiny.contain("ab"));
+static_assert(kTiny.contain("abc"));
+static_assert(kTiny.contain("b"));
+static_assert(!kTiny.contain("a"));
+static_assert(!kTiny.contain("abcd"));
+static_assert(kTiny.size() == 4);
+
+TEST_CASE("Static Trie") {
+  const std::vector<std::string> words = {"apple", "app", "application", "apricot", "banana", "band", "bat"};
+  Trie trie(words);
+  const std::vector<StaticTrie::Node> nodes = StaticTrie::flatten(trie);
+  const StaticTrie static_trie{nodes};
+
+  SECTION("Flattened layout matches the hand-written one") {
+    Trie tiny(std::vector<std::string>{"abc", "ab", "b"});
+    const std::vector<StaticTrie::Node> tiny_nodes = StaticTrie::flatten(tiny);
+    REQUIRE(tiny_nodes.size() == std::size(kTinyNodes));
+    for (size_t i = 0; i < tiny_nodes.size(); ++i) {
+      REQUIRE(tiny_nodes[i].first_child == kTinyNodes[i].first_child);
+      REQUIRE(tiny_nodes[i].child_count == kTinyNodes[i].child_count);
+      REQUIRE(tiny_nodes[i].label == kTinyNodes[i].label);
+      REQUIRE(tiny_nodes[i].end_of_word == kTinyNodes[i].end_of_word);
+    }
+  }
+
+  SECTION("Same contain semantics as Trie") {
+    for (const std::string word : {"apple", "app", "ap", "bat", "bats", "x", ""}) {
+      REQUIRE(static_trie.contain(word) == trie.contain(word));
+    }
+    REQUIRE(static_trie.size() == trie.size());
+  }
+
+  SECTION("Same autocomplete semantics as Trie") {
+    for (const std::string prefix : {"", "a", "ap", "app", "apple", "b", "ban", "xyz"}) {
+      REQUIRE(static_trie.autocomplete(prefix) == trie.autocomplete(prefix));
+      REQUIRE(static_trie.autocomplete(prefix, 2) == trie.autocomplete(prefix, 2));
+    }
+    REQUIRE(static_trie.autocomplete("ap", 0).empty());
+  }
+
+  SECTION("Empty dictionary") {
+    Trie empty;
+    const std::vector<StaticTrie::Node> empty_nodes = StaticTrie::flatten(empty);
+    const StaticTrie empty_static{empty_nodes};
+
+    REQUIRE(empty_static.size() == 0);
+    REQUIRE_FALSE(empty_static.contain("a"));
+    REQUIRE(empty_static.autocomplete("").empty());
+  }
+}
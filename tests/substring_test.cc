@@ -0,0 +1,72 @@
+#include <catch2/catch_all.hpp>
+#include <iostream>
+#include <random>
+#include <set>
+
+#include "../include/ct9/SubstringIndex.h"
+
+static std::set<std::string> asSet(std::queue<std::string> words) {
+  std::set<std::string> result;
+  while (!words.empty()) {
+    REQUIRE(result.insert(words.front()).second);
+    words.pop();
+  }
+  return result;
+}
+
+TEST_CASE("Substring Index") {
+  SECTION("Matches anywhere in the word") {
+    const SubstringIndex index(Trie(std::vector<std::string>{"application", "apply", "replica", "banana", "cat"}));
+    REQUIRE(asSet(index.contains_substring("plic")) == std::set<std::string>{"application", "replica"});
+    REQUIRE(asSet(index.contains_substring("ap")) == std::set<std::string>{"application", "apply"});
+    REQUIRE(asSet(index.contains_substring("ana")) == std::set<std::string>{"banana"});
+    REQUIRE(asSet(index.contains_substring("t")) == std::set<std::string>{"application", "cat"});
+    REQUIRE(asSet(index.contains_substring("cat")) == std::set<std::string>{"application", "cat"});
+    REQUIRE(asSet(index.contains_substring("ban")) == std::set<std::string>{"banana"});
+    REQUIRE(index.contains_substring("xyz").empty());
+    REQUIRE(index.contains_substring("applications").empty());
+    REQUIRE(index.contains_substring("").size() == 5);
+  }
+
+  SECTION("Count caps the results") {
+    const SubstringIndex index(Trie(std::vector<std::string>{"aa", "aaa", "baa", "aab", "b"}));
+    REQUIRE(index.contains_substring("aa", 2).size() == 2);
+    REQUIRE(index.contains_substring("aa", 0).empty());
+    REQUIRE(asSet(index.contains_substring("aa")) == std::set<std::string>{"aa", "aaa", "aab", "baa"});
+  }
+
+  SECTION("Empty dictionary") {
+    const SubstringIndex index{Trie()};
+    REQUIRE(index.contains_substring("a").empty());
+    REQUIRE(index.contains_substring("").empty());
+  }
+
+  SECTION("Same answers as scanning every word") {
+    std::mt19937 generator(11);
+    std::uniform_int_distribution<int> letter('a', 'd');
+    std::uniform_int_distribution<size_t> length(1, 8);
+    const auto random = [&](const size_t size) {
+      std::string word(size, ' ');
+      for (char& character : word) {
+        character = static_cast<char>(letter(generator));
+      }
+      return word;
+    };
+    std::vector<std::string> words;
+    for (int i = 0; i < 300; ++i) {
+      words.push_back(random(length(generator)));
+    }
+    const Trie trie(words);
+    const SubstringIndex index(trie);
+    for (int i = 0; i < 500; ++i) {
+      const std::string query = random(1 + i % 4);
+      std::set<std::string> expected;
+      for (std::queue<std::string> all = trie.autocomplete(""); !all.empty(); all.pop()) {
+        if (all.front().find(query) != std::string::npos) {
+          expected.insert(all.front());
+        }
+      }
+      REQUIRE(asSet(index.contains_substring(query)) == expected);
+    }
+  }
+}
@@ -0,0 +1,56 @@
+#include <catch2/catch_all.hpp>
+#include <iostream>
+
+#include "../include/ct9/T9Index.h"
+
+static_assert(t9Digit('a') == '2' && t9Digit('s') == '7' && t9Digit('z') == '9');
+static_assert(t9Digit('G') == '4' && t9Digit('1') == '\0');
+
+TEST_CASE("Trie T9 Lookup") {
+  const std::vector<std::string> words = {"good", "home", "gone", "hood", "goods", "in", "go", "Hoof"};
+  Trie trie(words);
+
+  SECTION("Exact-length keypad matches") {
+    REQUIRE(trie.t9_lookup("4663") == std::queue<std::string>({"Hoof", "gone", "good", "home", "hood"}));
+    REQUIRE(trie.t9_lookup("46") == std::queue<std::string>({"go", "in"}));
+    REQUIRE(trie.t9_lookup("46637") == std::queue<std::string>({"goods"}));
+  }
+
+  SECTION("Limits and misses") {
+    REQUIRE(trie.t9_lookup("4663", 2) == std::queue<std::string>({"Hoof", "gone"}));
+    REQUIRE(trie.t9_lookup("466").empty());
+    REQUIRE(trie.t9_lookup("2").empty());
+    REQUIRE(trie.t9_lookup("41").empty());
+    REQUIRE(trie.t9_lookup("").empty());
+  }
+
+  SECTION("Digit index agrees with the trie walk") {
+    T9Index index(trie);
+    REQUIRE(index.size() == words.size());
+    for (const std::string digits : {"4663", "46", "46637", "466", "2"}) {
+      REQUIRE(index.t9_lookup(digits) == trie.t9_lookup(digits));
+    }
+  }
+
+  SECTION("Digit index ranks by weight") {
+    T9Index index;
+    index.insert("good", 5);
+    index.insert("home", 10);
+    index.insert("gone", 5);
+    index.insert("hood");
+
+    REQUIRE(index.t9_lookup("4663") == std::queue<std::string>({"home", "gone", "good", "hood"}));
+    REQUIRE(index.t9_lookup("4663", 1) == std::queue<std::string>({"home"}));
+
+    index.insert("hood", 20);
+    REQUIRE(index.t9_lookup("4663", 1) == std::queue<std::string>({"hood"}));
+    REQUIRE(index.size() == 4);
+
+    index.del("hood");
+    index.del("missing");
+    REQUIRE(index.t9_lookup("4663", 1) == std::queue<std::string>({"home"}));
+    REQUIRE(index.size() == 3);
+    REQUIRE(T9Index::encode("good") == "4663");
+    REQUIRE(T9Index::encode("go od").empty());
+  }
+}
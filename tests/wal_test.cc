@@ -0,0 +1,113 @@
+#include <catch2/catch_all.hpp>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#include "../include/ct9/WriteAheadLog.h"
+
+TEST_CASE("Trie Write-Ahead Log") {
+  const std::filesystem::path directory = std::filesystem::temp_directory_path() / "ct9_wal_test";
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directories(directory);
+  const std::string snapshot = (directory / "ct9.snapshot").string();
+  const std::string log = (directory / "ct9.wal").string();
+
+  WriteAheadLog::Options options;
+  options.batch_records = 4;
+  options.batch_interval = std::chrono::milliseconds(5);
+  options.compact_records = 3;
+  options.fsync = false;
+
+  SECTION("Replay restores logged operations") {
+    {
+      WriteAheadLog wal(snapshot, log, options);
+      REQUIRE(wal.isOpen());
+      wal.insert("apple");
+      wal.insert("bat ball");
+      wal.del("bat");
+      wal.insert("cat");
+    }
+
+    Trie trie;
+    WriteAheadLog wal(snapshot, log, options);
+    REQUIRE_FALSE(wal.loadSnapshot(trie));
+    REQUIRE(wal.replay(trie) == 4);
+    REQUIRE(trie.autocomplete("") == std::queue<std::string>({"apple", "ball", "cat"}));
+    REQUIRE(wal.records() == 4);
+    REQUIRE(wal.needsCompaction());
+  }
+
+  SECTION("Sync makes records durable without closing the log") {
+    WriteAheadLog wal(snapshot, log, options);
+    wal.insert("apple");
+    REQUIRE(wal.sync());
+
+    Trie trie;
+    WriteAheadLog reader(snapshot, log, options);
+    REQUIRE(reader.replay(trie) == 1);
+    REQUIRE(trie.contain("apple"));
+  }
+
+  SECTION("A failed commit is reported and the records are kept") {
+    // Every write to /dev/full fails with ENOSPC.
+    WriteAheadLog wal(snapshot, "/dev/full", options);
+    REQUIRE(wal.isOpen());
+    wal.insert("apple");
+    REQUIRE_FALSE(wal.sync());
+    wal.insert("banana");
+    REQUIRE_FALSE(wal.sync());
+    REQUIRE(wal.records() == 2);
+    REQUIRE_FALSE(wal.compact(Trie("apple banana")));
+  }
+
+  SECTION("A torn tail is ignored and cut off") {
+    {
+      WriteAheadLog wal(snapshot, log, options);
+      wal.insert("apple");
+      wal.insert("banana");
+    }
+    const auto intact = std::filesystem::file_size(log);
+    std::filesystem::resize_file(log, intact - 3);
+
+    {
+      Trie trie;
+      WriteAheadLog wal(snapshot, log, options);
+      REQUIRE(wal.replay(trie) == 1);
+      REQUIRE(trie.contain("apple"));
+      REQUIRE_FALSE(trie.contain("banana"));
+      wal.insert("cherry");
+    }
+
+    Trie trie;
+    WriteAheadLog wal(snapshot, log, options);
+    REQUIRE(wal.replay(trie) == 2);
+    REQUIRE(trie.autocomplete("") == std::queue<std::string>({"apple", "cherry"}));
+  }
+
+  SECTION("Compaction writes a snapshot and empties the log") {
+    Trie trie;
+    {
+      WriteAheadLog wal(snapshot, log, options);
+      for (const std::string word : {"apple", "bat", "cat"}) {
+        trie.insert(word);
+        wal.insert(word);
+      }
+      trie.del("bat");
+      wal.del("bat");
+      REQUIRE(wal.compact(trie));
+      REQUIRE(wal.records() == 0);
+      REQUIRE(std::filesystem::file_size(log) == 0);
+
+      trie.insert("dog");
+      wal.insert("dog");
+    }
+
+    Trie restored;
+    WriteAheadLog wal(snapshot, log, options);
+    REQUIRE(wal.loadSnapshot(restored));
+    REQUIRE(wal.replay(restored) == 1);
+    REQUIRE(restored == trie);
+  }
+
+  std::filesystem::remove_all(directory);
+}
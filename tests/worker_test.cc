@@ -0,0 +1,74 @@
+#include <catch2/catch_all.hpp>
+#include <poll.h>
+
+#include <atomic>
+#include <iostream>
+
+#include "../include/ct9/SuggestionWorker.h"
+#include "../include/ct9/Trie.h"
+
+static SuggestionWorker::Result waitFor(SuggestionWorker& worker, const std::uint64_t ticket) {
+  while (true) {
+    pollfd descriptor{worker.fd(), POLLIN, 0};
+    REQUIRE(poll(&descriptor, 1, 5000) == 1);
+    if (auto result = worker.take(); result.has_value() && result->ticket == ticket) {
+      return std::move(*result);
+    }
+  }
+}
+
+TEST_CASE("Suggestion Worker") {
+  Trie trie(std::vector<std::string>{"apple", "application", "banana"});
+
+  SECTION("Results come back through take() with the ticket of their request") {
+    SuggestionWorker worker([&](const std::string& prefix) { return trie.autocomplete(prefix, 1); });
+    const std::uint64_t ticket = worker.request("app");
+    const SuggestionWorker::Result result = waitFor(worker, ticket);
+    REQUIRE(result.prefix == "app");
+    REQUIRE(result.words.front() == "apple");
+    REQUIRE_FALSE(worker.take().has_value());
+  }
+
+  SECTION("Requests made while the worker is busy collapse into the latest one") {
+    std::atomic<bool> release{false};
+    std::atomic<size_t> computed{0};
+    SuggestionWorker worker([&](const std::string& prefix) {
+      while (!release.load()) {
+        std::this_thread::yield();
+      }
+      ++computed;
+      return trie.autocomplete(prefix, 1);
+    });
+
+    static_cast<void>(worker.request("a"));
+    std::uint64_t ticket = 0;
+    for (const char* prefix : {"b", "ba", "ban"}) {
+      ticket = worker.request(prefix);
+    }
+    release = true;
+    const SuggestionWorker::Result result = waitFor(worker, ticket);
+    REQUIRE(result.prefix == "ban");
+    REQUIRE(result.words.front() == "banana");
+    REQUIRE(computed <= 2);
+    REQUIRE(worker.dropped() >= 2);
+  }
+
+  SECTION("Posted tasks run in order before the next suggestion") {
+    SuggestionWorker worker([&](const std::string& prefix) { return trie.autocomplete(prefix, 1); });
+    worker.post([&] { trie.insert("cherry"); });
+    worker.post([&] { trie.del("cherry"); });
+    worker.post([&] { trie.insert("citrus"); });
+    const SuggestionWorker::Result result = waitFor(worker, worker.request("c"));
+    REQUIRE(result.words.front() == "citrus");
+  }
+
+  SECTION("Tasks still queued run before the worker stops") {
+    {
+      SuggestionWorker worker([&](const std::string& prefix) { return trie.autocomplete(prefix, 1); });
+      for (int i = 0; i < 100; ++i) {
+        worker.post([&, i] { trie.insert("word" + std::string(1, static_cast<char>('a' + i % 26))); });
+      }
+    }
+    REQUIRE(trie.autocomplete("word").size() == 26);
+  }
+}
@@ -0,0 +1,55 @@
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+#include "../include/ct9/StaticTrie.h"
+
+/**
+ * Build-time dictionary compiler.
+ *
+ * Reads a word list with the same rules as the interactive loader in src/main.cc and writes a
+ * header holding the flattened trie as a constexpr StaticTrie named kDictionary.
+ *
+ * Usage: ct9_dictgen <words.txt> <Dictionary.h>
+ */
+int main(int argc, char** argv) {
+  if (argc != 3) {
+    std::cerr << "Usage: ct9_dictgen <words.txt> <Dictionary.h>\n";
+    return EXIT_FAILURE;
+  }
+
+  std::ifstream input(argv[1]);
+  if (!input.is_open()) {
+    std::cerr << "File opening error.\n";
+    return EXIT_FAILURE;
+  }
+
+  Trie t{};
+  std::string line;
+  while (std::getline(input, line)) {
+    t.insert(line);
+  }
+
+  const std::vector<StaticTrie::Node> nodes = StaticTrie::flatten(t);
+
+  std::ofstream output(argv[2]);
+  if (!output.is_open()) {
+    std::cerr << "File opening error.\n";
+    return EXIT_FAILURE;
+  }
+
+  output << "#pragma once\n"
+         << "// Generated by ct9_dictgen from " << argv[1] << ". Do not edit.\n"
+         << "#include \"ct9/StaticTrie.h\"\n\n"
+         << "inline constexpr StaticTrie::Node kDictionaryNodes[] = {\n";
+  for (const StaticTrie::Node& node : nodes) {
+    output << "    {" << node.first_child << "u, " << node.child_count << "u, " << static_cast<int>(node.label) << ", "
+           << (node.end_of_word ? "true" : "false") << "},\n";
+  }
+  output << "};\n\n"
+         << "inline constexpr StaticTrie kDictionary{kDictionaryNodes};\n";
+
+  std::cout << "ct9_dictgen: " << nodes.size() << " nodes, " << nodes.size() * sizeof(StaticTrie::Node)
+            << " bytes of trie data\n";
+  return output.good() ? EXIT_SUCCESS : EXIT_FAILURE;
+}